@@ -0,0 +1,83 @@
+#ifndef INICPP_ARENA_H
+#define INICPP_ARENA_H
+
+#include <cstddef>
+#include <deque>
+#include <memory_resource>
+
+#include "dll.h"
+
+
+namespace inicpp
+{
+	/**
+	 * Memory region for the whole tree of one config. Memory is handed out
+	 * from big blocks by bumping a pointer, single allocations are never
+	 * freed, all blocks are released at once when the arena is destroyed.
+	 *
+	 * Arena is not synchronized, one memory resource can be used only by one
+	 * thread at a time. Threads filling the same arena concurrently get their
+	 * own resources by @ref add_resource. All resources of one arena compare
+	 * equal, so containers move elements between them without copying.
+	 */
+	class INICPP_API arena
+	{
+	private:
+		/** Monotonic resource which compares equal to all resources of the same arena */
+		class region : public std::pmr::monotonic_buffer_resource
+		{
+		private:
+			/** Arena which owns this region */
+			const arena *owner_;
+
+		protected:
+			bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+		public:
+			/**
+			 * Construct empty region of given arena.
+			 * @param owner arena which owns this region
+			 * @param block_size size of the first block, following blocks grow geometrically
+			 */
+			region(const arena *owner, size_t block_size);
+		};
+
+		/** Regions of this arena, deque keeps their addresses stable */
+		std::deque<region> regions_;
+		/** Size of the first block of every region */
+		size_t block_size_;
+
+	public:
+		/** Default size of the first block of every resource */
+		static constexpr size_t default_block_size = 16 * 1024;
+
+		/**
+		 * Construct arena with one memory resource, no memory is allocated yet.
+		 * @param block_size size of the first block of every resource
+		 */
+		explicit arena(size_t block_size = default_block_size);
+		/**
+		 * Deleted copy constructor, memory is owned by exactly one arena.
+		 */
+		arena(const arena &source) = delete;
+		/**
+		 * Deleted copy assignment, memory is owned by exactly one arena.
+		 */
+		arena &operator=(const arena &source) = delete;
+
+		/**
+		 * Memory resource created with this arena.
+		 * @return pointer to resource valid for the lifetime of the arena
+		 */
+		std::pmr::memory_resource *get_resource();
+		/**
+		 * Creates another memory resource of this arena, which can be used
+		 * by other thread concurrently with existing resources.
+		 * Creation itself has to be synchronized with other calls of this method.
+		 * @return pointer to resource valid for the lifetime of the arena
+		 */
+		std::pmr::memory_resource *add_resource();
+	};
+}
+
+#endif // INICPP_ARENA_H
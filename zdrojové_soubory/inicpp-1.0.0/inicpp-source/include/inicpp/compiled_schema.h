@@ -0,0 +1,186 @@
+#ifndef INICPP_COMPILED_SCHEMA_H
+#define INICPP_COMPILED_SCHEMA_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dll.h"
+#include "exception.h"
+#include "option_schema.h"
+#include "types.h"
+
+
+namespace inicpp
+{
+	/** Forward declarations, stated because of ring dependencies */
+	class config;
+	class schema;
+	class section;
+
+
+	/**
+	 * Immutable validation plan created from schema by schema::compile().
+	 * Names of sections and options are placed in perfect hash tables, so every
+	 * name of the config is looked up by one probe, and validators are bound
+	 * to their value types in advance. Config is validated in one pass over its
+	 * sections and options. Config passes validation by the plan exactly when
+	 * it passes validation by the schema and it is changed in the same way then.
+	 * If config contains several errors, reported error may differ from the one
+	 * reported by the schema, because the plan follows the order of the config
+	 * instead of the order of the schema, and failed config may be changed differently.
+	 *
+	 * Plan does not depend on the schema it was created from and all its
+	 * methods are const, so one plan can validate many configs concurrently,
+	 * provided validators of the schema can be called concurrently too.
+	 */
+	class INICPP_API compiled_schema
+	{
+	private:
+		/**
+		 * Perfect hash table of names, each name of the table has its own slot,
+		 * so lookup takes one probe. Names are split into small buckets and every
+		 * bucket gets seed of the slot function, under which its names do not
+		 * collide with names of other buckets (hash and displace scheme).
+		 */
+		class name_table
+		{
+		private:
+			/** Content of one slot of the table */
+			struct slot {
+				/** Hash of the name from name_index::hash() */
+				uint64_t hash;
+				/** Position of the named item, empty_slot if the slot is not used */
+				size_t position;
+			};
+			/** Value of position of unused slot */
+			static constexpr size_t empty_slot = static_cast<size_t>(-1);
+			/** Count of seeds tried for one bucket before it is moved to overflow */
+			static constexpr uint32_t max_seed = 1 << 16;
+
+			/** Slots of the table, count is power of two */
+			std::vector<slot> slots_;
+			/** Seeds of slot function for buckets, count is power of two */
+			std::vector<uint32_t> seeds_;
+			/** Names which could not be placed, possible only if their hashes are equal */
+			std::vector<slot> overflow_;
+
+			/**
+			 * Slot of name with given hash.
+			 * @param name_hash hash of the name
+			 * @param seed seed of bucket of the name
+			 * @return index of slot
+			 */
+			size_t slot_of(uint64_t name_hash, uint32_t seed) const;
+
+		public:
+			/** Value returned if name is not found */
+			static constexpr size_t npos = static_cast<size_t>(-1);
+
+			/**
+			 * Construct table of given names, position of name is its index in the list.
+			 * @param hashes hashes of distinct names
+			 */
+			explicit name_table(const std::vector<uint64_t> &hashes = {});
+			/**
+			 * Finds position of name with given hash.
+			 * @param name_hash hash of searched name
+			 * @param name searched name
+			 * @param name_of function which returns name of item on given position
+			 * @return position of the name or npos
+			 */
+			template <typename NameOf> size_t find(uint64_t name_hash, std::string_view name, NameOf name_of) const
+			{
+				const slot &found = slots_[slot_of(name_hash, seeds_[name_hash & (seeds_.size() - 1)])];
+				if (found.position != empty_slot && found.hash == name_hash && name_of(found.position) == name) {
+					return found.position;
+				}
+				for (const slot &extra : overflow_) {
+					if (extra.hash == name_hash && name_of(extra.position) == name) {
+						return extra.position;
+					}
+				}
+				return npos;
+			}
+		};
+
+		/** Validation plan of one option */
+		struct option_plan {
+			/** Name of the option */
+			std::string name;
+			/** Determines whether option is mandatory */
+			bool mandatory;
+			/** Value of missing optional option */
+			std::string default_value;
+			/** Validation bound to the type of the option schema */
+			option_schema::bound_validator validate;
+		};
+
+		/** Validation plan of one section */
+		struct section_plan {
+			/** Name of the section */
+			std::string name;
+			/** Determines whether section is mandatory */
+			bool mandatory;
+			/** Plans of options in the order of the schema */
+			std::vector<option_plan> options;
+			/** Table of option names */
+			name_table options_table;
+		};
+
+		/** Plans of sections in the order of the schema */
+		std::vector<section_plan> sections_;
+		/** Table of section names */
+		name_table sections_table_;
+
+		/**
+		 * Finds plan of section with given name.
+		 * @param section_name searched name
+		 * @return position of section plan or name_table::npos
+		 */
+		size_t find_section(std::string_view section_name) const;
+		/**
+		 * Validate section against given plan.
+		 * @param sect validated section
+		 * @param plan plan of section with the same name
+		 * @param mode validation mode
+		 * @param found reused buffer for marks of found options
+		 * @throws validation_exception if section is not valid
+		 */
+		void validate_section(section &sect, const section_plan &plan, schema_mode mode, std::vector<bool> &found) const;
+
+	public:
+		/**
+		 * Compiles given schema, which can be changed or destroyed afterwards.
+		 * @param schm compiled schema
+		 */
+		explicit compiled_schema(const schema &schm);
+
+		/**
+		 * Returns count of section schemas.
+		 * @return unsigned integer
+		 */
+		size_t size() const;
+		/**
+		 * Tries to find section schema with specified name.
+		 * @param section_name name which is searched
+		 * @return true if section schema with this name is present, false otherwise
+		 */
+		bool contains(std::string_view section_name) const;
+
+		/**
+		 * Validate cfg against this plan in specified mode. Missing optional sections
+		 * and options are added with their default values like schema does.
+		 * Errors are reported in the order of sections and options of the config,
+		 * missing mandatory options of a section follow its present options
+		 * and missing mandatory sections come last.
+		 * @param cfg configuration which will be validated
+		 * @param mode validation mode
+		 * @throws validation_exception if config cannot be validated
+		 */
+		void validate_config(config &cfg, schema_mode mode) const;
+	};
+}
+
+#endif // INICPP_COMPILED_SCHEMA_H
@@ -1,13 +1,23 @@
 #ifndef INICPP_CONFIG_H
 #define INICPP_CONFIG_H
 
+#include <cstddef>
 #include <iostream>
-#include <map>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
+#include "arena.h"
+#include "compiled_schema.h"
 #include "dll.h"
 #include "exception.h"
+#include "executor.h"
+#include "name_index.h"
 #include "option.h"
+#include "option_key.h"
 #include "schema.h"
 #include "section.h"
 
@@ -24,55 +34,129 @@ namespace inicpp
 	 * Represents the base object of ini configuration.
 	 * Contains list of sections in logical map structure.
 	 * Can be constructed directly from string or stream.
+	 * Sections are stored contiguously, so references to them are invalidated
+	 * by adding or removing sections.
+	 * Whole tree of sections, options and values is allocated from memory
+	 * resource given on construction, copies use default memory resource.
+	 * Assignment keeps memory resource of the target, so the tree is moved
+	 * without copying only if both configs have equal resources.
 	 */
 	class INICPP_API config
 	{
 	private:
-		using sections_vector = std::vector<std::shared_ptr<section>>;
-		using sections_map = std::map<std::string, std::shared_ptr<section>>;
-		using sections_map_pair = std::pair<std::string, std::shared_ptr<section>>;
+		using sections_vector = std::pmr::vector<section>;
 
+		/**
+		 * Arena from which the whole tree is allocated, nullptr if the config
+		 * does not own its memory. Arena is not synchronized, so it is owned
+		 * by one config only, moved from config leaves it to the moved one.
+		 */
+		std::shared_ptr<arena> arena_;
 		/** List of sections in this config instance */
 		sections_vector sections_;
-		/** Map of sections for better searching */
-		sections_map sections_map_;
+		/** Hash index of section names for better searching */
+		name_index index_;
+
+		/**
+		 * Finds position of section with given name.
+		 * @param section_name searched name
+		 * @param name_hash hash of searched name from name_index::hash()
+		 * @return position in sections list or name_index::npos
+		 */
+		size_t find_section(std::string_view section_name, uint64_t name_hash) const;
+		/**
+		 * Finds position of section with given name.
+		 * @param section_name searched name
+		 * @return position in sections list
+		 * @throws not_found_exception if section with given name does not exist
+		 */
+		size_t section_position(std::string_view section_name) const;
+		/**
+		 * Appends section to sections list and indexes it.
+		 * @param sect section which name is not in this config
+		 * @param name_hash hash of section name from name_index::hash()
+		 */
+		void push_section(section &&sect, uint64_t name_hash);
+		/**
+		 * Gives up the arena of moved from config, empty containers are recreated
+		 * with the default memory resource, so the config can be reused by another
+		 * thread than the one which uses the arena.
+		 */
+		void detach_arena() noexcept;
+
+		/**
+		 * Construct empty config which allocates everything from given arena.
+		 * @param memory arena owned by the config and its moved instances
+		 */
+		explicit config(std::shared_ptr<arena> memory);
 
 		friend class config_iterator<section>;
 		friend class config_iterator<const section>;
+		friend class option_handle;
+		friend class config_builder;
+		friend class parser;
+		friend class schema;
 
 	public:
 		/** type of iterator */
 		using iterator = config_iterator<section>;
 		/** type of const iterator */
 		using const_iterator = config_iterator<const section>;
+		/** Type of allocator, which determines memory resource of the config */
+		using allocator_type = std::pmr::polymorphic_allocator<char>;
 
 		/**
 		 * Default constructor.
 		 */
 		config();
 		/**
-		 * Copy constructor.
+		 * Construct empty config which allocates its tree by given allocator.
+		 * Memory resource has to outlive the config.
+		 * @param alloc allocator of sections, options and values
+		 */
+		explicit config(const allocator_type &alloc);
+		/**
+		 * Copy constructor, copy uses default memory resource.
 		 */
 		config(const config &source);
 		/**
-		 * Copy assignment.
+		 * Copy constructor with given allocator.
+		 */
+		config(const config &source, const allocator_type &alloc);
+		/**
+		 * Copy assignment, memory resource of this config stays the same.
 		 */
 		config &operator=(const config &source);
 		/**
-		 * Move constructor.
+		 * Move constructor, takes over memory of the source. Source which owned
+		 * an arena uses the default memory resource afterwards.
 		 */
-		config(config &&source);
+		config(config &&source) noexcept;
 		/**
-		 * Move assignment.
+		 * Move assignment, memory resource of this config stays the same,
+		 * so sections are copied if allocators differ. Source which owned
+		 * an arena uses the default memory resource afterwards.
 		 */
 		config &operator=(config &&source);
 
+		/**
+		 * Allocator of the tree of this config.
+		 * @return copy of allocator
+		 */
+		allocator_type get_allocator() const;
+
 		/**
 		 * Add section to this ini configuration.
 		 * @param sect section which will be added
 		 * @throws ambiguity_exception if section with specified name exists
 		 */
 		void add_section(const section &sect);
+		/**
+		 * Add section to this ini configuration without copying its options.
+		 * @param sect section which will be moved into the config
+		 * @throws ambiguity_exception if section with specified name exists
+		 */
+		void add_section(section &&sect);
 		/**
 		 * Create and add section with specified name.
 		 * @param section_name section with same name cannot exist in config
@@ -104,14 +188,7 @@ namespace inicpp
 		template <typename ValueType>
 		void add_option(const std::string &section_name, const std::string &option_name, ValueType value)
 		{
-			auto sect_it = sections_map_.find(section_name);
-			if (sect_it != sections_map_.end()) {
-				option opt(option_name);
-				opt.set<ValueType>(value);
-				sect_it->second->add_option(opt);
-			} else {
-				throw not_found_exception(section_name);
-			}
+			sections_[section_position(section_name)].add_option<ValueType>(option_name, value);
 		}
 
 		/**
@@ -149,20 +226,46 @@ namespace inicpp
 		 * @return modifiable reference to stored section
 		 * @throws not_found_exception if section with given name does not exist
 		 */
-		section &operator[](const std::string &section_name);
+		section &operator[](std::string_view section_name);
 		/**
 		 * Access constant reference on section with specified name.
 		 * @param section_name name of requested section
 		 * @return constant reference to stored section
 		 * @throws not_found_exception if section with given name does not exist
 		 */
-		const section &operator[](const std::string &section_name) const;
+		const section &operator[](std::string_view section_name) const;
 		/**
 		 * Tries to find section with specified name inside this config.
 		 * @param section_name name which is searched
 		 * @return true if section with this name is present, false otherwise
 		 */
-		bool contains(const std::string &section_name) const;
+		bool contains(std::string_view section_name) const;
+
+		/**
+		 * Access option specified by key, hashes of key names are not computed again.
+		 * @param key section and option name, usually created by INICPP_KEY
+		 * @return modifiable reference to stored option
+		 * @throws not_found_exception if section or option with given name does not exist
+		 */
+		option &get_option(const option_key &key);
+		/**
+		 * Access constant reference on option specified by key.
+		 * @param key section and option name, usually created by INICPP_KEY
+		 * @return constant reference to stored option
+		 * @throws not_found_exception if section or option with given name does not exist
+		 */
+		const option &get_option(const option_key &key) const;
+		/**
+		 * Get single value of option specified by key.
+		 * @param key section and option name, usually created by INICPP_KEY
+		 * @return value of option converted to ValueType
+		 * @throws not_found_exception if section or option with given name does not exist
+		 * @throws bad_cast_exception if value cannot be converted to ValueType
+		 */
+		template <typename ValueType> ValueType get(const option_key &key) const
+		{
+			return get_option(key).get<ValueType>();
+		}
 
 		/**
 		 * Validates this config agains given schema.
@@ -171,6 +274,22 @@ namespace inicpp
 		 * @throws validation_exception if error occured
 		 */
 		void validate(const schema &schm, schema_mode mode);
+		/**
+		 * Validates this config agains given schema, sections are validated
+		 * concurrently by given executor (see schema::validate_config).
+		 * @param schm specifies how this config should look like
+		 * @param mode validation mode
+		 * @param exec executor which runs validation of sections
+		 * @throws validation_exception if error occured
+		 */
+		void validate(const schema &schm, schema_mode mode, executor &exec);
+		/**
+		 * Validates this config against given compiled schema.
+		 * @param plan compiled schema which specifies how this config should look like
+		 * @param mode validation mode
+		 * @throws validation_exception if error occured
+		 */
+		void validate(const compiled_schema &plan, schema_mode mode);
 
 		/**
 		 * Equality operator.
@@ -231,9 +350,8 @@ namespace inicpp
 	/**
 	 * Templated config iterator.
 	 * Templates provide const and non-const iterator in one implementation.
-	 * For easier implementation inheritance from std::iterator is used.
 	 */
-	template <typename Element> class config_iterator : public std::iterator<std::random_access_iterator_tag, Element>
+	template <typename Element> class config_iterator
 	{
 	private:
 		/** Reference to container which can be iterated */
@@ -242,8 +360,16 @@ namespace inicpp
 		size_t position_;
 
 	public:
-		using typename std::iterator<std::random_access_iterator_tag, Element>::reference;
-		using typename std::iterator<std::random_access_iterator_tag, Element>::pointer;
+		/** category of the iterator */
+		using iterator_category = std::random_access_iterator_tag;
+		/** type of iterated elements */
+		using value_type = std::remove_cv_t<Element>;
+		/** type of distance between iterators */
+		using difference_type = std::ptrdiff_t;
+		/** pointer to iterated element */
+		using pointer = Element *;
+		/** reference to iterated element */
+		using reference = Element &;
 
 		/**
 		 * Deleted default constructor.
@@ -337,7 +463,7 @@ namespace inicpp
 		 */
 		reference operator*()
 		{
-			return *container_.sections_.at(position_);
+			return container_.sections_.at(position_);
 		}
 
 		/**
@@ -0,0 +1,120 @@
+#ifndef INICPP_CONFIG_BUILDER_H
+#define INICPP_CONFIG_BUILDER_H
+
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "dll.h"
+#include "exception.h"
+#include "option.h"
+#include "section.h"
+
+
+namespace inicpp
+{
+	/**
+	 * Builds config section by section in place. Sections and options are
+	 * created directly in the config or moved into it, so nothing is copied
+	 * on the way. Options are always added to the last section, which makes
+	 * building of large configs a sequence of appends.
+	 * Builder is used by the parser and can be used for programmatic
+	 * construction of configs too.
+	 */
+	class INICPP_API config_builder
+	{
+	private:
+		/** Config which is being built */
+		config cfg_;
+
+	public:
+		/** Type of allocator, which determines memory resource of the built config */
+		using allocator_type = config::allocator_type;
+
+		/**
+		 * Construct builder of empty config with default memory resource.
+		 */
+		config_builder();
+		/**
+		 * Construct builder of empty config which allocates its tree by given allocator.
+		 * @param alloc allocator of sections, options and values
+		 */
+		explicit config_builder(const allocator_type &alloc);
+		/**
+		 * Construct builder which appends to given config.
+		 * @param cfg config moved into the builder
+		 */
+		explicit config_builder(config &&cfg);
+		/**
+		 * Deleted copy constructor, builder exclusively owns the config.
+		 */
+		config_builder(const config_builder &source) = delete;
+		/**
+		 * Deleted copy assignment, builder exclusively owns the config.
+		 */
+		config_builder &operator=(const config_builder &source) = delete;
+
+		/**
+		 * Allocator of the built config.
+		 * @return copy of allocator
+		 */
+		allocator_type get_allocator() const;
+
+		/**
+		 * Creates empty section at the end of the config.
+		 * @param section_name name of the new section
+		 * @return reference to created section valid until the next section is added
+		 * @throws ambiguity_exception if section with specified name exists
+		 */
+		section &add_section(const std::string &section_name);
+		/**
+		 * Moves given section at the end of the config.
+		 * Options are copied only if section uses memory resource different from the config.
+		 * @param sect section which will be moved into the config
+		 * @return reference to stored section valid until the next section is added
+		 * @throws ambiguity_exception if section with specified name exists
+		 */
+		section &add_section(section &&sect);
+		/**
+		 * Last added section, which receives added options.
+		 * @return reference valid until the next section is added
+		 * @throws not_found_exception if no section was added yet
+		 */
+		section &last_section();
+
+		/**
+		 * Moves given option at the end of the last section.
+		 * @param opt option which will be moved into the section
+		 * @return reference to stored option valid until the next option is added
+		 * @throws not_found_exception if no section was added yet
+		 * @throws ambiguity_exception if option with specified name exists in the last section
+		 */
+		option &add_option(option &&opt);
+		/**
+		 * Creates option with given values at the end of the last section.
+		 * Values are moved into the option, they are not parsed nor converted.
+		 * @param option_name name of the new option
+		 * @param values string values of the new option
+		 * @return reference to stored option valid until the next option is added
+		 * @throws not_found_exception if no section was added yet
+		 * @throws ambiguity_exception if option with specified name exists in the last section
+		 */
+		option &add_option(const std::string &option_name, std::vector<std::string> &&values);
+
+		/**
+		 * Number of sections added so far.
+		 * @return unsigned integer
+		 */
+		size_t size() const;
+
+		/**
+		 * Finishes building and hands the config over, builder is empty afterwards
+		 * and keeps the memory resource of the built config. Arena is handed over
+		 * with the config, builder uses the default memory resource then.
+		 * @return built config
+		 */
+		config build();
+	};
+}
+
+#endif // INICPP_CONFIG_BUILDER_H
@@ -0,0 +1,62 @@
+#ifndef INICPP_EXECUTOR_H
+#define INICPP_EXECUTOR_H
+
+#include <cstddef>
+#include <functional>
+
+#include "dll.h"
+
+
+namespace inicpp
+{
+	/**
+	 * Runs batches of independent tasks, which can be executed concurrently.
+	 * Derived classes can delegate tasks to thread pool of the application.
+	 */
+	class INICPP_API executor
+	{
+	public:
+		/**
+		 * Virtual destructor supplied because the class is expected to be derived.
+		 */
+		virtual ~executor();
+
+		/**
+		 * Calls task with every index from 0 to count - 1 and returns after all calls
+		 * finished. Calls can run concurrently and in any order. Task does not throw.
+		 * @param count number of tasks
+		 * @param task function called with index of the task
+		 */
+		virtual void run(size_t count, const std::function<void(size_t)> &task) = 0;
+	};
+
+
+	/**
+	 * Executor which starts its own threads for every batch. Calling thread
+	 * takes part in execution, threads take tasks one by one until none is left.
+	 */
+	class INICPP_API thread_executor : public executor
+	{
+	private:
+		/** Maximal number of threads executing one batch */
+		size_t threads_;
+
+	public:
+		/**
+		 * Construct executor with given number of threads.
+		 * @param threads maximal number of threads including the calling one,
+		 * 0 means number of hardware threads
+		 */
+		explicit thread_executor(size_t threads = 0);
+
+		/**
+		 * Returns maximal number of threads executing one batch.
+		 * @return positive number
+		 */
+		size_t get_threads() const;
+
+		void run(size_t count, const std::function<void(size_t)> &task) override;
+	};
+}
+
+#endif // INICPP_EXECUTOR_H
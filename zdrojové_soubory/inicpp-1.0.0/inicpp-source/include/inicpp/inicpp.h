@@ -6,14 +6,26 @@
  * library from external projekt.
  */
 
+#include "arena.h"
+#include "compiled_schema.h"
 #include "config.h"
+#include "config_builder.h"
 #include "exception.h"
+#include "executor.h"
+#include "memoized_validator.h"
+#include "name_index.h"
 #include "option.h"
+#include "option_handle.h"
+#include "option_key.h"
 #include "option_schema.h"
 #include "parser.h"
+#include "parser_options.h"
 #include "schema.h"
 #include "section.h"
 #include "section_schema.h"
+#include "small_vector.h"
 #include "types.h"
+#include "value_constraints.h"
+#include "value_view.h"
 
 #endif // INICPP_MAIN_H
@@ -0,0 +1,204 @@
+#ifndef INICPP_MEMOIZED_VALIDATOR_H
+#define INICPP_MEMOIZED_VALIDATOR_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+#include "types.h"
+
+
+namespace inicpp
+{
+	/**
+	 * Counters of memoized validators.
+	 */
+	struct memo_statistics {
+		/** Number of values whose result was remembered */
+		size_t hits = 0;
+		/** Number of values passed to the validator */
+		size_t misses = 0;
+		/** Number of results forgotten because the cache was full */
+		size_t evictions = 0;
+		/** Number of currently remembered results */
+		size_t size = 0;
+
+		/**
+		 * Adds counters of another validator.
+		 * @param other added counters
+		 * @return reference to this instance
+		 */
+		memo_statistics &operator+=(const memo_statistics &other)
+		{
+			hits += other.hits;
+			misses += other.misses;
+			evictions += other.evictions;
+			size += other.size;
+			return *this;
+		}
+	};
+
+	/**
+	 * Counters of distinct caches of memoized validators, keyed by identity
+	 * of the cache, so copies of one validator are counted once.
+	 */
+	using memo_caches = std::map<const void *, memo_statistics>;
+
+
+	/**
+	 * Validator which remembers results of another validator for recently
+	 * validated values, so expensive validators are called once for values
+	 * which recur across options, sections or reloads of config. At most given
+	 * number of results is kept, the least recently used one is forgotten first.
+	 *
+	 * Wrapped validator has to be a pure function of the value, then results
+	 * do not depend on the content of the cache. Exceptions thrown by it are
+	 * not remembered. Floating point values are compared by their bits, so
+	 * NaN and negative zero are remembered separately, locales are never
+	 * remembered, because unnamed locales cannot be told apart.
+	 *
+	 * Copies share the cache and its statistics, so validator can be assigned
+	 * to option_schema_params<ValueType>::validator and remain shared by all
+	 * copies of the schema. It can be called concurrently, wrapped validator
+	 * is not called under the lock.
+	 */
+	template <typename ValueType> class memoized_validator
+	{
+	private:
+		/** Order of remembered values, compares floating point values by bits */
+		struct value_less {
+			bool operator()(const ValueType &first, const ValueType &second) const
+			{
+				if constexpr (std::is_floating_point<ValueType>::value) {
+					uint64_t first_bits;
+					uint64_t second_bits;
+					static_assert(sizeof(ValueType) == sizeof(uint64_t), "Unexpected size of floating point value");
+					std::memcpy(&first_bits, &first, sizeof(first_bits));
+					std::memcpy(&second_bits, &second, sizeof(second_bits));
+					return first_bits < second_bits;
+				} else {
+					return first < second;
+				}
+			}
+		};
+
+		/** Remembered result of the validator */
+		struct entry {
+			/** Result for the value */
+			bool valid;
+			/** Position in the list of values ordered by last use */
+			typename std::list<const ValueType *>::iterator usage;
+		};
+
+		/** Cache shared by all copies of the validator */
+		struct shared_state {
+			/** Wrapped validator */
+			std::function<bool(ValueType)> validator;
+			/** Maximal number of remembered results */
+			size_t capacity;
+			/** Guards all following members */
+			std::mutex mutex;
+			/** Remembered results */
+			std::map<ValueType, entry, value_less> results;
+			/** Keys of results, the most recently used first */
+			std::list<const ValueType *> usage;
+			/** Counters of the cache */
+			memo_statistics statistics;
+		};
+
+		/** State of the validator */
+		std::shared_ptr<shared_state> state_;
+
+	public:
+		/**
+		 * Construct memoizing wrapper of given validator.
+		 * @param validator wrapped validator
+		 * @param capacity maximal number of remembered results, at least one
+		 */
+		memoized_validator(std::function<bool(ValueType)> validator, size_t capacity)
+			: state_(std::make_shared<shared_state>())
+		{
+			state_->validator = std::move(validator);
+			state_->capacity = capacity == 0 ? 1 : capacity;
+		}
+
+		/**
+		 * Validate given value, wrapped validator is called only if result is not remembered.
+		 * @param value validated value
+		 * @return result of the wrapped validator
+		 */
+		bool operator()(ValueType value) const
+		{
+			shared_state &state = *state_;
+			if constexpr (std::is_same<ValueType, locale_ini_t>::value) {
+				return state.validator(value);
+			} else {
+				{
+					std::lock_guard<std::mutex> lock(state.mutex);
+					auto found = state.results.find(value);
+					if (found != state.results.end()) {
+						++state.statistics.hits;
+						state.usage.splice(state.usage.begin(), state.usage, found->second.usage);
+						return found->second.valid;
+					}
+					++state.statistics.misses;
+				}
+
+				bool valid = state.validator(value);
+
+				std::lock_guard<std::mutex> lock(state.mutex);
+				auto inserted = state.results.emplace(value, entry{valid, state.usage.end()});
+				if (inserted.second) {
+					// value could be remembered by another thread meanwhile, with the same result
+					state.usage.push_front(&inserted.first->first);
+					inserted.first->second.usage = state.usage.begin();
+					if (state.results.size() > state.capacity) {
+						auto oldest = state.results.find(*state.usage.back());
+						state.usage.pop_back();
+						state.results.erase(oldest);
+						++state.statistics.evictions;
+					}
+				}
+				return valid;
+			}
+		}
+
+		/**
+		 * Current counters of the cache.
+		 * @return copy of counters
+		 */
+		memo_statistics statistics() const
+		{
+			std::lock_guard<std::mutex> lock(state_->mutex);
+			memo_statistics result = state_->statistics;
+			result.size = state_->results.size();
+			return result;
+		}
+
+		/**
+		 * Identity of the cache, which is the same for all copies of this validator.
+		 * @return address of the shared cache
+		 */
+		const void *cache_id() const
+		{
+			return state_.get();
+		}
+
+		/**
+		 * Forgets all remembered results, counters are kept.
+		 */
+		void clear()
+		{
+			std::lock_guard<std::mutex> lock(state_->mutex);
+			state_->results.clear();
+			state_->usage.clear();
+		}
+	};
+}
+
+#endif // INICPP_MEMOIZED_VALIDATOR_H
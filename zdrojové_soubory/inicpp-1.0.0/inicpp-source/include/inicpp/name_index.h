@@ -0,0 +1,226 @@
+#ifndef INICPP_NAME_INDEX_H
+#define INICPP_NAME_INDEX_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include "dll.h"
+
+
+namespace inicpp
+{
+	/**
+	 * Open addressing hash index over names of elements stored contiguously
+	 * in some container (options in section, sections in config). Index does
+	 * not own any names, it stores only positions of elements in container
+	 * and asks container for element names through @p NameOf callable, which
+	 * maps position to name.
+	 *
+	 * Slots are kept in one flat array with linear probing, each slot holds
+	 * part of the name hash, so most of the mismatches are resolved without
+	 * touching the container. Names are hashed by SipHash-1-3 keyed by random
+	 * per-process key, so collisions cannot be forced by crafted input.
+	 *
+	 * Every arrangement of indexed names has its layout identifier, which
+	 * is shared by copies of the index and changes on insertion or removal.
+	 * Equal identifiers guarantee equal positions of all names.
+	 */
+	class INICPP_API name_index
+	{
+	private:
+		/** One slot of the hash table */
+		struct slot {
+			/** Upper half of name hash */
+			uint32_t tag;
+			/** Position of element in container, @ref empty_slot if unused */
+			uint32_t position;
+		};
+
+		/** Position marking unused slot */
+		static constexpr uint32_t empty_slot = UINT32_MAX;
+
+		/** Hash table, its size is zero or power of two */
+		std::pmr::vector<slot> slots_;
+		/** Number of indexed names */
+		size_t size_;
+		/** Layout identifier, zero until it is requested after a change */
+		mutable std::atomic<uint64_t> layout_;
+
+		/**
+		 * Assigns new process-wide unique layout identifier if there is none.
+		 * @return current layout identifier
+		 */
+		uint64_t assign_layout() const;
+
+		/**
+		 * Stores position to the first unused slot on probe sequence of hash.
+		 * Table has to contain at least one unused slot.
+		 */
+		void place(uint64_t hash, size_t position)
+		{
+			size_t mask = slots_.size() - 1;
+			size_t i = hash & mask;
+			while (slots_[i].position != empty_slot) {
+				i = (i + 1) & mask;
+			}
+			slots_[i] = slot{static_cast<uint32_t>(hash >> 32), static_cast<uint32_t>(position)};
+		}
+
+	public:
+		/** Value returned by find methods if name is not indexed */
+		static constexpr size_t npos = static_cast<size_t>(-1);
+		/** Type of allocator of hash table */
+		using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+		/**
+		 * Default constructor creates empty index.
+		 */
+		name_index();
+		/**
+		 * Creates empty index which allocates hash table by given allocator.
+		 * @param alloc allocator of hash table
+		 */
+		explicit name_index(const allocator_type &alloc);
+		/**
+		 * Copy constructor, copy has the same layout.
+		 */
+		name_index(const name_index &source);
+		/**
+		 * Copy constructor with given allocator, copy has the same layout.
+		 */
+		name_index(const name_index &source, const allocator_type &alloc);
+		/**
+		 * Copy assignment, copy has the same layout.
+		 */
+		name_index &operator=(const name_index &source);
+		/**
+		 * Move constructor, source is left empty.
+		 */
+		name_index(name_index &&source) noexcept;
+		/**
+		 * Move constructor with given allocator, hash table is copied
+		 * if allocators differ. Source is left empty.
+		 */
+		name_index(name_index &&source, const allocator_type &alloc);
+		/**
+		 * Move assignment, hash table is copied if allocators differ.
+		 * Source is left empty.
+		 */
+		name_index &operator=(name_index &&source);
+
+		/**
+		 * Keyed hash function used by all indexes.
+		 * @param name hashed name
+		 * @return 64-bit hash of name
+		 */
+		static uint64_t hash(std::string_view name);
+
+		/**
+		 * Number of indexed names.
+		 * @return unsigned integer
+		 */
+		size_t size() const
+		{
+			return size_;
+		}
+
+		/**
+		 * Identifier of current arrangement of indexed names, never zero.
+		 * @return layout identifier
+		 */
+		uint64_t layout() const
+		{
+			uint64_t id = layout_.load(std::memory_order_relaxed);
+			return id != 0 ? id : assign_layout();
+		}
+
+		/**
+		 * Finds position of element with given name.
+		 * @param name searched name
+		 * @param name_of callable returning name of element on given position
+		 * @return position of element or @ref npos if not found
+		 */
+		template <typename NameOf> size_t find(std::string_view name, NameOf name_of) const
+		{
+			if (size_ == 0) {
+				return npos;
+			}
+			return find(name, hash(name), name_of);
+		}
+
+		/**
+		 * Finds position of element with given name and precomputed hash.
+		 * @param name searched name
+		 * @param name_hash result of @ref hash for @p name
+		 * @param name_of callable returning name of element on given position
+		 * @return position of element or @ref npos if not found
+		 */
+		template <typename NameOf> size_t find(std::string_view name, uint64_t name_hash, NameOf name_of) const
+		{
+			if (size_ == 0) {
+				return npos;
+			}
+			size_t mask = slots_.size() - 1;
+			uint32_t tag = static_cast<uint32_t>(name_hash >> 32);
+			for (size_t i = name_hash & mask;; i = (i + 1) & mask) {
+				const slot &current = slots_[i];
+				if (current.position == empty_slot) {
+					return npos;
+				}
+				if (current.tag == tag && name_of(current.position) == name) {
+					return current.position;
+				}
+			}
+		}
+
+		/**
+		 * Indexes element which was appended to the container. Positions
+		 * of already indexed elements have to be 0 to size() - 1 and the new
+		 * one has to be size(), name of the new element cannot be indexed yet.
+		 * @param name_hash result of @ref hash for name of appended element
+		 * @param name_of callable returning name of element on given position
+		 */
+		template <typename NameOf> void insert(uint64_t name_hash, NameOf name_of)
+		{
+			// keep load factor at most one half, probe sequences stay short
+			if ((size_ + 1) * 2 > slots_.size()) {
+				rebuild(size_, name_of, slots_.empty() ? 8 : slots_.size() * 2);
+			}
+			place(name_hash, size_);
+			++size_;
+			layout_.store(0, std::memory_order_relaxed);
+		}
+
+		/**
+		 * Builds index again for elements on positions 0 to count - 1,
+		 * used after elements were removed from the container.
+		 * @param count number of elements in the container
+		 * @param name_of callable returning name of element on given position
+		 * @param capacity minimal number of slots
+		 */
+		template <typename NameOf> void rebuild(size_t count, NameOf name_of, size_t capacity = 0)
+		{
+			size_t needed = 8;
+			while (needed < capacity || needed < count * 2) {
+				needed *= 2;
+			}
+			slots_.assign(needed, slot{0, empty_slot});
+			for (size_t i = 0; i < count; ++i) {
+				place(hash(name_of(i)), i);
+			}
+			size_ = count;
+			layout_.store(0, std::memory_order_relaxed);
+		}
+
+		/**
+		 * Removes all names from index.
+		 */
+		void clear();
+	};
+}
+
+#endif // INICPP_NAME_INDEX_H
@@ -1,16 +1,23 @@
 #ifndef INICPP_OPTION_H
 #define INICPP_OPTION_H
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <variant>
 #include <vector>
 
 #include "dll.h"
 #include "exception.h"
 #include "option_schema.h"
+#include "small_vector.h"
 #include "string_utils.h"
 #include "types.h"
+#include "value_view.h"
 
 
 namespace inicpp
@@ -20,62 +27,111 @@ namespace inicpp
 
 
 	/**
-	 * Base class for option_value objects,
-	 * which allows storing templated option values in option instance.
+	 * List of option values of one type. Values which fit into 32 bytes
+	 * are stored inline, so single values and short lists need no allocation.
+	 * Longer lists are allocated from memory resource of the option.
 	 */
-	class option_holder
-	{
-	public:
-		/**
-		 * Has to be stated for completion.
-		 */
-		virtual ~option_holder()
-		{
-		}
-	};
+	template <typename ValueType>
+	using value_list = small_vector<ValueType,
+		(sizeof(ValueType) < 32 ? 32 / sizeof(ValueType) : 1),
+		std::pmr::polymorphic_allocator<ValueType>>;
+
+	/**
+	 * Values of option, one contiguous list for each supported type.
+	 * Alternatives are in the order of option_type enumeration,
+	 * so index of the active alternative is type of the option.
+	 */
+	using option_values = std::variant<value_list<boolean_ini_t>,
+		value_list<signed_ini_t>,
+		value_list<unsigned_ini_t>,
+		value_list<float_ini_t>,
+		value_list<enum_ini_t>,
+		value_list<string_ini_t>,
+		value_list<date_ini_t>,
+		value_list<locale_ini_t>>;
+
+	/**
+	 * One value of any supported type, alternatives are in the order of option_type enumeration.
+	 */
+	using option_single_value = std::variant<boolean_ini_t,
+		signed_ini_t,
+		unsigned_ini_t,
+		float_ini_t,
+		enum_ini_t,
+		string_ini_t,
+		date_ini_t,
+		locale_ini_t>;
 
 
 	/**
-	 * Class which actually stores option value in templated manner.
-	 * Getter and setter of course provided.
+	 * Result of the first successful typed conversion of option value.
+	 * It is filled at most once, so concurrent readers can share it without
+	 * locking. Clearing needs exclusive access as any other option modification.
 	 */
-	template <typename ValueType> class option_value : public option_holder
+	class conversion_cache
 	{
+	private:
+		/** Published converted value, nullptr if nothing was converted yet */
+		std::atomic<option_single_value *> entry_;
+
 	public:
 		/**
-		 * Construct option_value with given value.
-		 * @param value value which will be stored
+		 * Construct empty cache.
 		 */
-		option_value(ValueType value) : value_(value)
+		conversion_cache() : entry_(nullptr)
 		{
 		}
 		/**
-		 * Stated for completion.
+		 * Deleted copy constructor, cache belongs to exactly one option.
+		 */
+		conversion_cache(const conversion_cache &source) = delete;
+		/**
+		 * Deleted copy assignment, cache belongs to exactly one option.
+		 */
+		conversion_cache &operator=(const conversion_cache &source) = delete;
+		/**
+		 * Frees cached value.
 		 */
-		virtual ~option_value()
+		~conversion_cache()
 		{
+			clear();
 		}
 
 		/**
-		 * Get this instance internal value.
-		 * @return returned by value
+		 * Find cached value of given type.
+		 * @return cached value or nullptr if there is no value of ValueType
 		 */
-		ValueType get()
+		template <typename ValueType> const ValueType *find() const
 		{
-			return value_;
+			option_single_value *cached = entry_.load(std::memory_order_acquire);
+			if (cached == nullptr) {
+				return nullptr;
+			}
+			return std::get_if<ValueType>(cached);
 		}
+
 		/**
-		 * Set internal value to given one.
-		 * @param value
+		 * Remember given value, unless some value is already cached.
+		 * Can be called concurrently with find() and other store() calls.
+		 * @param value converted value
 		 */
-		void set(ValueType value)
+		template <typename ValueType> void store(const ValueType &value)
 		{
-			value_ = value;
+			auto created = std::make_unique<option_single_value>(std::in_place_type<ValueType>, value);
+
+			option_single_value *expected = nullptr;
+			if (entry_.compare_exchange_strong(expected, created.get(), std::memory_order_acq_rel)) {
+				created.release();
+			}
 		}
 
-	private:
-		/** Stored option value. */
-		ValueType value_;
+		/**
+		 * Forget cached value, has to be called whenever option value changes.
+		 */
+		void clear()
+		{
+			delete entry_.exchange(nullptr, std::memory_order_acq_rel);
+		}
 	};
 
 
@@ -95,20 +151,15 @@ namespace inicpp
 		{
 		public:
 			/**
-			 * Get value of type ActualType from value argument and try to convert it
-			 * to ReturnType.
-			 * @param value Pointer to internal representation of option value
+			 * Try to convert value of type ActualType to ReturnType.
+			 * @param value stored option value
 			 * @return Converted option value
 			 * @throws bad_cast_exception if such cast cannot be made
 			 */
-			static ReturnType get_converted_value(const std::unique_ptr<option_holder> &value)
+			static ReturnType get_converted_value(const ActualType &value)
 			{
-				option_value<ActualType> *ptr = dynamic_cast<option_value<ActualType> *>(&*value);
-				if (ptr == nullptr) {
-					throw bad_cast_exception("Cannot cast to requested type");
-				}
 				try {
-					return static_cast<ReturnType>(ptr->get());
+					return static_cast<ReturnType>(value);
 				} catch (std::runtime_error &e) {
 					throw bad_cast_exception(e.what());
 				}
@@ -121,13 +172,9 @@ namespace inicpp
 		template <typename ActualType> class convertor<ActualType, string_ini_t>
 		{
 		public:
-			static string_ini_t get_converted_value(const std::unique_ptr<option_holder> &value)
+			static string_ini_t get_converted_value(const ActualType &value)
 			{
-				option_value<ActualType> *ptr = dynamic_cast<option_value<ActualType> *>(&*value);
-				if (ptr == nullptr) {
-					throw bad_cast_exception("Cannot cast to requested type");
-				}
-				return inistd::to_string(ptr->get());
+				return inistd::to_string(value);
 			}
 		};
 	} // anonymous namespace
@@ -136,90 +183,110 @@ namespace inicpp
 	 * Represent ini configuration option.
 	 * Can store one element or list of elements.
 	 * Stored elements should have only supported types from option_type enum.
+	 * Lists of values which do not fit into the option are allocated from
+	 * memory resource given on construction, containers of options pass their
+	 * own resource to stored options. Copies use default memory resource.
 	 */
 	class INICPP_API option
 	{
 	private:
 		/** Name of this ini option */
 		std::string name_;
-		/** Type of this ini option */
-		option_type type_;
-		/** Values which corresponds with this option */
-		std::vector<std::unique_ptr<option_holder>> values_;
-		/** Corresponding option_schema if any */
-		std::shared_ptr<option_schema> option_schema_;
-
-		/** Save copy of opt option into self */
-		template <typename ValueType> void copy_option(const std::unique_ptr<option_holder> &opt)
+		/** Values which corresponds with this option, active list determines type of option */
+		option_values values_;
+		/** First value parsed from string by get(), filled lazily even on const option */
+		mutable conversion_cache cache_;
+
+		/** List of values of ValueType, which has to be the type of this option */
+		template <typename ValueType> const value_list<ValueType> &typed_values() const
 		{
-			option_value<ValueType> *ptr = dynamic_cast<option_value<ValueType> *>(&*opt);
-			auto new_option_value = std::make_unique<option_value<ValueType>>(ptr->get());
-			values_.push_back(std::move(new_option_value));
+			return *std::get_if<value_list<ValueType>>(&values_);
 		}
 
-		/** Compare local and remote option values, both of ValueType type. */
-		template <typename ValueType>
-		bool compare_option(
-			const std::unique_ptr<option_holder> &local, const std::unique_ptr<option_holder> &remote) const
+		/** List of values of ValueType, which has to be the type of this option */
+		template <typename ValueType> value_list<ValueType> &typed_values()
 		{
-			option_value<ValueType> *loc = dynamic_cast<option_value<ValueType> *>(&*local);
-			option_value<ValueType> *rem = dynamic_cast<option_value<ValueType> *>(&*remote);
-			return loc->get() == rem->get();
+			return *std::get_if<value_list<ValueType>>(&values_);
 		}
 
-		template <typename ReturnType>
-		ReturnType convert_single_value(option_type source_type, const std::unique_ptr<option_holder> &value) const
+		/** Number of stored values */
+		size_t values_count() const
 		{
-			switch (source_type) {
-			case option_type::boolean_e: return convertor<boolean_ini_t, ReturnType>::get_converted_value(value); break;
-			case option_type::enum_e: return convertor<enum_ini_t, ReturnType>::get_converted_value(value); break;
-			case option_type::float_e: return convertor<float_ini_t, ReturnType>::get_converted_value(value); break;
-			case option_type::signed_e: return convertor<signed_ini_t, ReturnType>::get_converted_value(value); break;
-			case option_type::string_e: {
-				option_value<string_ini_t> *ptr = dynamic_cast<option_value<string_ini_t> *>(&*value);
-				if (ptr == nullptr) {
-					throw bad_cast_exception("Cannot cast to requested type");
-				}
+			return std::visit([](const auto &list) { return list.size(); }, values_);
+		}
 
+		/** Replace all values by single value of ValueType */
+		template <typename ValueType> option &assign_single(ValueType value)
+		{
+			cache_.clear();
+			values_.template emplace<value_list<ValueType>>(get_allocator()).push_back(std::move(value));
+			return *this;
+		}
+
+		template <typename ReturnType> ReturnType convert_single_value(size_t position) const
+		{
+			switch (get_type()) {
+			case option_type::boolean_e:
+				return convertor<boolean_ini_t, ReturnType>::get_converted_value(
+					typed_values<boolean_ini_t>()[position]);
+			case option_type::enum_e:
+				return convertor<enum_ini_t, ReturnType>::get_converted_value(typed_values<enum_ini_t>()[position]);
+			case option_type::float_e:
+				return convertor<float_ini_t, ReturnType>::get_converted_value(typed_values<float_ini_t>()[position]);
+			case option_type::signed_e:
+				return convertor<signed_ini_t, ReturnType>::get_converted_value(typed_values<signed_ini_t>()[position]);
+			case option_type::string_e:
 				// We have string, so try to parse it
 				try {
-					return string_utils::parse_string<ReturnType>(ptr->get(), get_name());
+					return string_utils::parse_string<ReturnType>(typed_values<string_ini_t>()[position], get_name());
 				} catch (invalid_type_exception &e) {
 					throw bad_cast_exception(e.what());
 				}
-			} break;
 			case option_type::unsigned_e:
-				return convertor<unsigned_ini_t, ReturnType>::get_converted_value(value);
-				break;
-			case option_type::date_e: return convertor<date_ini_t, ReturnType>::get_converted_value(value); break;
-			case option_type::locale_e: return convertor<locale_ini_t, ReturnType>::get_converted_value(value); break;
+				return convertor<unsigned_ini_t, ReturnType>::get_converted_value(
+					typed_values<unsigned_ini_t>()[position]);
+			case option_type::date_e:
+				return convertor<date_ini_t, ReturnType>::get_converted_value(typed_values<date_ini_t>()[position]);
+			case option_type::locale_e:
+				return convertor<locale_ini_t, ReturnType>::get_converted_value(typed_values<locale_ini_t>()[position]);
 			case option_type::invalid_e:
 			default:
 				// never reached
 				throw invalid_type_exception("Invalid option type");
-				break;
 			}
 		}
 
 	public:
+		/** Type of allocator, which determines memory resource of the option */
+		using allocator_type = std::pmr::polymorphic_allocator<char>;
+
 		/**
 		 * Default constructor is deleted.
 		 */
 		option() = delete;
 		/**
-		 * Copy constructor.
+		 * Copy constructor, copy uses default memory resource.
 		 */
 		option(const option &source);
 		/**
-		 * Copy assignment.
+		 * Copy constructor with given allocator.
+		 */
+		option(const option &source, const allocator_type &alloc);
+		/**
+		 * Copy assignment, memory resource of this option stays the same.
 		 */
 		option &operator=(const option &source);
 		/**
 		 * Move constructor.
 		 */
-		option(option &&source);
+		option(option &&source) noexcept;
+		/**
+		 * Move constructor with given allocator, values are copied if allocators differ.
+		 */
+		option(option &&source, const allocator_type &alloc);
 		/**
-		 * Move assignment.
+		 * Move assignment, memory resource of this option stays the same,
+		 * so values are copied if allocators differ.
 		 */
 		option &operator=(option &&source);
 
@@ -227,14 +294,45 @@ namespace inicpp
 		 * Construct ini option with specified value of specified type.
 		 * @param name name of newly created option
 		 * @param value initial value
+		 * @param alloc allocator of value lists
 		 */
-		option(const std::string &name, const std::string &value = "");
+		option(const std::string &name, const std::string &value = "", const allocator_type &alloc = allocator_type());
 		/**
 		 * Construct ini option with specified value of specified list type.
 		 * @param name name of newly created option
 		 * @param values initial value
+		 * @param alloc allocator of value lists
 		 */
-		option(const std::string &name, const std::vector<std::string> &values);
+		option(const std::string &name, const std::vector<std::string> &values,
+			const allocator_type &alloc = allocator_type());
+		/**
+		 * Construct ini option with specified value of specified list type.
+		 * Given strings are moved into the option instead of being copied.
+		 * @param name name of newly created option
+		 * @param values initial value
+		 * @param alloc allocator of value lists
+		 */
+		option(const std::string &name, std::vector<std::string> &&values,
+			const allocator_type &alloc = allocator_type());
+		/**
+		 * Construct ini option with list of already typed values, type of the list
+		 * becomes type of the option. List is moved into the option, its buffer
+		 * is taken over if it was allocated by the same allocator.
+		 * @param name name of newly created option
+		 * @param values initial values
+		 * @param alloc allocator of value lists
+		 */
+		template <typename ValueType>
+		option(const std::string &name, value_list<ValueType> &&values, const allocator_type &alloc = allocator_type())
+			: name_(name), values_(std::in_place_type<value_list<ValueType>>, std::move(values), alloc)
+		{
+		}
+
+		/**
+		 * Allocator of value lists of this option.
+		 * @return copy of allocator
+		 */
+		allocator_type get_allocator() const;
 
 		/**
 		 * Gets this option name.
@@ -327,14 +425,54 @@ namespace inicpp
 		 */
 		template <typename ReturnType> ReturnType get() const
 		{
-			if (values_.empty()) {
+			if (values_count() == 0) {
 				throw not_found_exception(0);
 			}
 
+			if constexpr (get_option_enum_type<ReturnType>() != option_type::invalid_e) {
+				// value of the same type is returned directly
+				if (get_type() == get_option_enum_type<ReturnType>()) {
+					return typed_values<ReturnType>()[0];
+				}
+				// strings are parsed only once, until the value changes
+				if (get_type() == option_type::string_e) {
+					if (auto cached = cache_.find<ReturnType>()) {
+						return *cached;
+					}
+					ReturnType result = convert_single_value<ReturnType>(0);
+					cache_.store(result);
+					return result;
+				}
+			}
+
 			// Get the value and try to convert it
-			return convert_single_value<ReturnType>(type_, values_[0]);
+			return convert_single_value<ReturnType>(0);
+		}
+
+		/**
+		 * Get reference to single element value without copying it.
+		 * If option value is list, than reference to the first element is returned.
+		 * Stored value is not converted, so ReturnType has to be type of this option.
+		 * Reference is valid until option is modified.
+		 * @return constant reference to stored value
+		 * @throws bad_cast_exception if ReturnType is not type of this option
+		 * @throws not_found_exception if there is no value
+		 */
+		template <typename ReturnType> const ReturnType &get_ref() const
+		{
+			return get_view<ReturnType>().front();
 		}
 
+		/**
+		 * Get single string value without copying it.
+		 * If option value is list, than the first element is returned.
+		 * Returned view is valid until option is modified.
+		 * @return view of stored string
+		 * @throws bad_cast_exception if option does not contain strings
+		 * @throws not_found_exception if there is no value
+		 */
+		std::string_view get_string_view() const;
+
 		/**
 		 * Set internal list of values to given one.
 		 * If option contained single value than its transformed to list
@@ -345,10 +483,11 @@ namespace inicpp
 		 */
 		template <typename ValueType> void set_list(const std::vector<ValueType> &list)
 		{
-			values_.clear();
-			type_ = get_option_enum_type<ValueType>();
-			for (const auto &item : list) {
-				add_to_list(item);
+			if constexpr (get_option_enum_type<ValueType>() == option_type::invalid_e) {
+				throw bad_cast_exception("Cannot cast to requested type");
+			} else {
+				cache_.clear();
+				values_.template emplace<value_list<ValueType>>(list.begin(), list.end(), get_allocator());
 			}
 		}
 
@@ -362,17 +501,50 @@ namespace inicpp
 		 */
 		template <typename ReturnType> std::vector<ReturnType> get_list() const
 		{
-			if (values_.empty()) {
+			size_t count = values_count();
+			if (count == 0) {
 				throw not_found_exception(0);
 			}
+			if constexpr (get_option_enum_type<ReturnType>() != option_type::invalid_e) {
+				if (get_type() == get_option_enum_type<ReturnType>()) {
+					const auto &list = typed_values<ReturnType>();
+					return std::vector<ReturnType>(list.begin(), list.end());
+				}
+			}
+
 			std::vector<ReturnType> results;
-			for (const auto &value : values_) {
-				results.push_back(convert_single_value<ReturnType>(type_, value));
+			results.reserve(count);
+			for (size_t i = 0; i < count; ++i) {
+				results.push_back(convert_single_value<ReturnType>(i));
 			}
 
 			return results;
 		}
 
+		/**
+		 * Get read-only view of all stored values, no list is created.
+		 * Stored values are not converted, so ReturnType has to be type
+		 * of this option. View is valid until option is modified.
+		 * @return view over stored values, single value is view with one element
+		 * @throws bad_cast_exception if ReturnType is not type of this option
+		 * @throws not_found_exception if there is no value
+		 */
+		template <typename ReturnType> value_view<ReturnType> get_view() const
+		{
+			if constexpr (get_option_enum_type<ReturnType>() == option_type::invalid_e) {
+				throw bad_cast_exception("Cannot cast to requested type");
+			} else {
+				if (get_type() != get_option_enum_type<ReturnType>()) {
+					throw bad_cast_exception("Cannot cast to requested type");
+				}
+				const auto &list = typed_values<ReturnType>();
+				if (list.empty()) {
+					throw not_found_exception(0);
+				}
+				return value_view<ReturnType>(list.data(), list.size());
+			}
+		}
+
 		/**
 		 * Adds element to internal value list.
 		 * If option was single value than its transformed to list.
@@ -381,11 +553,15 @@ namespace inicpp
 		 */
 		template <typename ValueType> void add_to_list(ValueType value)
 		{
-			if (get_option_enum_type<ValueType>() != type_) {
+			if constexpr (get_option_enum_type<ValueType>() == option_type::invalid_e) {
 				throw bad_cast_exception("Cannot cast to requested type");
+			} else {
+				if (get_option_enum_type<ValueType>() != get_type()) {
+					throw bad_cast_exception("Cannot cast to requested type");
+				}
+				cache_.clear();
+				typed_values<ValueType>().push_back(std::move(value));
 			}
-			auto new_option_value = std::make_unique<option_value<ValueType>>(value);
-			values_.push_back(std::move(new_option_value));
 		}
 
 		/**
@@ -398,14 +574,19 @@ namespace inicpp
 		 */
 		template <typename ValueType> void add_to_list(ValueType value, size_t position)
 		{
-			if (get_option_enum_type<ValueType>() != type_) {
+			if constexpr (get_option_enum_type<ValueType>() == option_type::invalid_e) {
 				throw bad_cast_exception("Cannot cast to requested type");
+			} else {
+				if (get_option_enum_type<ValueType>() != get_type()) {
+					throw bad_cast_exception("Cannot cast to requested type");
+				}
+				auto &list = typed_values<ValueType>();
+				if (position > list.size()) {
+					throw not_found_exception(position);
+				}
+				cache_.clear();
+				list.insert(list.begin() + position, std::move(value));
 			}
-			if (position > values_.size()) {
-				throw not_found_exception(position);
-			}
-			auto new_option_value = std::make_unique<option_value<ValueType>>(value);
-			values_.insert(values_.begin() + position, std::move(new_option_value));
 		}
 
 		/**
@@ -415,14 +596,17 @@ namespace inicpp
 		 */
 		template <typename ValueType> void remove_from_list(ValueType value)
 		{
-			if (get_option_enum_type<ValueType>() != type_) {
+			if constexpr (get_option_enum_type<ValueType>() == option_type::invalid_e) {
 				throw bad_cast_exception("Cannot cast to requested type");
-			}
-			for (auto it = values_.cbegin(); it != values_.cend(); ++it) {
-				option_value<ValueType> *ptr = dynamic_cast<option_value<ValueType> *>(&*(*it));
-				if (ptr->get() == value) {
-					values_.erase(it);
-					break;
+			} else {
+				if (get_option_enum_type<ValueType>() != get_type()) {
+					throw bad_cast_exception("Cannot cast to requested type");
+				}
+				auto &list = typed_values<ValueType>();
+				auto it = std::find(list.begin(), list.end(), value);
+				if (it != list.end()) {
+					cache_.clear();
+					list.erase(it);
 				}
 			}
 		}
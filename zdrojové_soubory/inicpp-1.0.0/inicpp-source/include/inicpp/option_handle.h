@@ -0,0 +1,107 @@
+#ifndef INICPP_OPTION_HANDLE_H
+#define INICPP_OPTION_HANDLE_H
+
+#include <cstdint>
+#include <string>
+
+#include "config.h"
+#include "dll.h"
+#include "exception.h"
+
+
+namespace inicpp
+{
+	/**
+	 * Option looked up once by section and option name. Handle remembers
+	 * positions of the option in config together with layouts of the config
+	 * and the section, so following accesses are only two comparisons and
+	 * two indexations without any hashing. When layout differs (options were
+	 * added or removed, config was reloaded or another config is accessed),
+	 * option is found by its names again.
+	 *
+	 * Access can remap the handle, so one handle cannot be used by more
+	 * threads at once, each thread should have its own handles.
+	 */
+	class INICPP_API option_handle
+	{
+	private:
+		/** Name of section which contains the option */
+		std::string section_name_;
+		/** Name of the option */
+		std::string option_name_;
+		/** Layout of config for which positions are valid, zero if not mapped yet */
+		uint64_t config_layout_;
+		/** Layout of section for which option position is valid */
+		uint64_t section_layout_;
+		/** Position of section in config */
+		size_t section_position_;
+		/** Position of option in section */
+		size_t option_position_;
+
+		/**
+		 * Finds option by names and remembers its positions and layouts.
+		 * @throws not_found_exception if section or option does not exist
+		 */
+		const option &remap(const config &cfg);
+
+	public:
+		/**
+		 * Default constructor is deleted.
+		 */
+		option_handle() = delete;
+		/**
+		 * Construct handle which is mapped on the first access.
+		 * @param section_name name of section which contains the option
+		 * @param option_name name of the option
+		 */
+		option_handle(const std::string &section_name, const std::string &option_name);
+		/**
+		 * Construct handle mapped to the option in given config.
+		 * @param cfg config which contains the option
+		 * @param section_name name of section which contains the option
+		 * @param option_name name of the option
+		 * @throws not_found_exception if section or option does not exist
+		 */
+		option_handle(const config &cfg, const std::string &section_name, const std::string &option_name);
+
+		/**
+		 * Getter for name of section which contains the option.
+		 * @return section name
+		 */
+		const std::string &get_section_name() const;
+		/**
+		 * Getter for name of the option.
+		 * @return option name
+		 */
+		const std::string &get_option_name() const;
+
+		/**
+		 * Access the option in given config.
+		 * @param cfg config which contains the option
+		 * @return constant reference to stored option
+		 * @throws not_found_exception if layout changed and option does not exist anymore
+		 */
+		const option &get(const config &cfg)
+		{
+			if (cfg.index_.layout() == config_layout_) {
+				const section &sect = cfg.sections_[section_position_];
+				if (sect.index_.layout() == section_layout_) {
+					return sect.options_[option_position_];
+				}
+			}
+			return remap(cfg);
+		}
+		/**
+		 * Access the option in given config.
+		 * @param cfg config which contains the option
+		 * @return modifiable reference to stored option
+		 * @throws not_found_exception if layout changed and option does not exist anymore
+		 */
+		option &get(config &cfg)
+		{
+			return const_cast<option &>(get(static_cast<const config &>(cfg)));
+		}
+	};
+}
+
+#endif // INICPP_OPTION_HANDLE_H
@@ -0,0 +1,121 @@
+#ifndef INICPP_OPTION_KEY_H
+#define INICPP_OPTION_KEY_H
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+#include "dll.h"
+#include "name_index.h"
+
+
+namespace inicpp
+{
+	/**
+	 * Section and option name pair with cached hashes of both names.
+	 * Key does not own the names, they have to outlive it, which is always
+	 * true for string literals. Hashes of name indexes are keyed by random
+	 * per-process key, so they cannot be computed at compile time. Instead
+	 * key is constant initialized and computes the hashes on the first use,
+	 * following lookups with the same key only compare names with equal
+	 * hash tags. Keys for literal names are created by @ref INICPP_KEY,
+	 * keys for names known at runtime can be constructed directly.
+	 */
+	class INICPP_API option_key
+	{
+	private:
+		/** Name of section */
+		std::string_view section_name_;
+		/** Name of option */
+		std::string_view option_name_;
+		/** Hash of section name, zero if not computed yet */
+		mutable std::atomic<uint64_t> section_hash_;
+		/** Hash of option name, zero if not computed yet */
+		mutable std::atomic<uint64_t> option_hash_;
+
+		/**
+		 * Returns cached hash of name or computes and caches it.
+		 * Hash which is zero is valid, it is only computed every time.
+		 */
+		static uint64_t cached_hash(std::atomic<uint64_t> &cache, std::string_view name)
+		{
+			uint64_t result = cache.load(std::memory_order_relaxed);
+			if (result == 0) {
+				result = name_index::hash(name);
+				cache.store(result, std::memory_order_relaxed);
+			}
+			return result;
+		}
+
+	public:
+		/**
+		 * Construct key from section and option names.
+		 * @param section_name name of section, has to outlive the key
+		 * @param option_name name of option, has to outlive the key
+		 */
+		constexpr option_key(std::string_view section_name, std::string_view option_name)
+			: section_name_(section_name), option_name_(option_name), section_hash_(0), option_hash_(0)
+		{
+		}
+		/**
+		 * Copy constructor, cached hashes are copied too.
+		 */
+		option_key(const option_key &source)
+			: section_name_(source.section_name_), option_name_(source.option_name_),
+			  section_hash_(source.section_hash_.load(std::memory_order_relaxed)),
+			  option_hash_(source.option_hash_.load(std::memory_order_relaxed))
+		{
+		}
+		/**
+		 * Copy assignment is deleted, key is immutable.
+		 */
+		option_key &operator=(const option_key &source) = delete;
+
+		/**
+		 * Getter for section name.
+		 * @return section name
+		 */
+		std::string_view section_name() const
+		{
+			return section_name_;
+		}
+		/**
+		 * Getter for option name.
+		 * @return option name
+		 */
+		std::string_view option_name() const
+		{
+			return option_name_;
+		}
+		/**
+		 * Hash of section name for name indexes.
+		 * @return result of name_index::hash() for section name
+		 */
+		uint64_t section_hash() const
+		{
+			return cached_hash(section_hash_, section_name_);
+		}
+		/**
+		 * Hash of option name for name indexes.
+		 * @return result of name_index::hash() for option name
+		 */
+		uint64_t option_hash() const
+		{
+			return cached_hash(option_hash_, option_name_);
+		}
+	};
+}
+
+/**
+ * Key for section and option given by string literals. Every use of the macro
+ * has its own constant initialized key, so names are hashed once per process.
+ * Names which are not literals cannot be used, construct inicpp::option_key instead.
+ * Macro contains lambda, so it cannot appear in unevaluated operands like sizeof.
+ */
+#define INICPP_KEY(section_name, option_name)                                          \
+	([]() -> const ::inicpp::option_key & {                                            \
+		static ::inicpp::option_key key_of_call_site((section_name), (option_name)); \
+		return key_of_call_site;                                                       \
+	}())
+
+#endif // INICPP_OPTION_KEY_H
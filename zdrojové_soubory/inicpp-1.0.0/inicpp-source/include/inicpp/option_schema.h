@@ -3,13 +3,18 @@
 
 #include <functional>
 #include <iostream>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "dll.h"
 #include "exception.h"
+#include "memoized_validator.h"
 #include "option.h"
 #include "types.h"
+#include "value_constraints.h"
+#include "value_view.h"
 
 namespace inicpp
 {
@@ -48,9 +53,15 @@ namespace inicpp
 		}
 		/**
 		 * Validating function - takes one argument of @a ArgType
-		 * and returns bool if valid or not
+		 * and returns bool if valid or not. Expensive validators can be
+		 * wrapped in memoized_validator, which remembers their results.
 		 */
 		std::function<bool(ArgType)> validator = nullptr;
+		/**
+		 * Declarative constraints of values, which are checked for all values
+		 * of the option at once before the validator is called.
+		 */
+		value_constraints<ArgType> constraints;
 	};
 
 
@@ -80,38 +91,13 @@ namespace inicpp
 			return std::move(new_schema_value);
 		}
 
+	public:
 		/**
-		 * Run provided validator on all items in option.
-		 * @param opt
+		 * Standalone validation function, which validates option
+		 * the same way as validate_option() does.
 		 */
-		void validate_option_items(option &opt) const;
-
-		template <typename ValueType>
-		void validate_typed_option_items(const std::vector<ValueType> &items, const std::string &option_name) const
-		{
-			for (const auto &item : items) {
-				option_schema_params<ValueType> *ptr = dynamic_cast<option_schema_params<ValueType> *>(&*params_);
-				if (ptr != nullptr && ptr->validator != nullptr && !ptr->validator(item)) {
-					throw validation_exception("Option '" + option_name + "' - validation failed");
-				}
-			}
-		}
-
-		void parse_option_items(option &opt) const;
+		using bound_validator = std::function<void(option &)>;
 
-		template <typename ValueType>
-		std::vector<ValueType> parse_typed_option_items(const std::vector<std::string> &items,
-			std::function<ValueType(const std::string &, const std::string &)> parser,
-			const std::string &option_name) const
-		{
-			std::vector<ValueType> typed_items;
-			for (const auto &item : items) {
-				typed_items.push_back(parser(item, option_name));
-			}
-			return typed_items;
-		}
-
-	public:
 		/**
 		 * Deleted default constructor.
 		 */
@@ -185,6 +171,39 @@ namespace inicpp
 		 * @throws validation_exception if error occured
 		 */
 		void validate_option(option &opt) const;
+		/**
+		 * Binds validation against this schema into standalone function.
+		 * Dispatch on the type of the schema is done once here and the function
+		 * holds its own copy of the validator, so it does not depend on lifetime
+		 * of this schema.
+		 * @return function which validates given option
+		 */
+		bound_validator bind_validator() const;
+		/**
+		 * Statistics of memoized validator of this schema. Copies of the validator
+		 * share the cache, so counters include use by all schemas which hold them.
+		 * @return counters of the validator, zeros if it is not memoized_validator
+		 */
+		memo_statistics get_memo_statistics() const;
+		/**
+		 * Adds statistics of memoized validator of this schema to given caches,
+		 * unless its cache is already there.
+		 * @param caches counters of already collected caches
+		 */
+		void collect_memo_statistics(memo_caches &caches) const;
+		/**
+		 * Creates option of the type of this schema from escaped string values.
+		 * Each value is parsed straight into the list of the option, so it is
+		 * converted only once and no list of strings is created. Created option
+		 * is not validated, but its validation only runs the validator then.
+		 * @param option_name name of created option
+		 * @param values escaped values as they were read by the parser
+		 * @param alloc allocator of value lists of created option
+		 * @return created option
+		 * @throws invalid_type_exception if some value cannot be parsed
+		 */
+		option parse_option(const std::string &option_name, const std::vector<std::string_view> &values,
+			const std::pmr::polymorphic_allocator<char> &alloc) const;
 
 		/**
 		 * To given output stream writes additional information about option.
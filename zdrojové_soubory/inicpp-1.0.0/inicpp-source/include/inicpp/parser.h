@@ -3,25 +3,81 @@
 
 #include <fstream>
 #include <iostream>
-#include <regex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <stack>
 
 #include "config.h"
+#include "config_builder.h"
 #include "dll.h"
 #include "exception.h"
+#include "parser_options.h"
 #include "schema.h"
 #include "string_utils.h"
 
 namespace inicpp
 {
+	/**
+	* Receiver of events produced by parser::parse() while it goes through
+	* ini configuration. No config is built, so handler can stream through
+	* input of any size in constant memory. All string views passed to the
+	* handler are valid only during the call.
+	* Default implementations ignore the events, except on_error() which throws.
+	*/
+	class INICPP_API parse_handler
+	{
+	public:
+		/**
+		* Virtual destructor supplied because the class is expected to be derived.
+		*/
+		virtual ~parse_handler() {};
+
+		/**
+		* Start of new section.
+		* @param name unescaped and validated section name
+		* @param line_number number of line with section header
+		*/
+		virtual void on_section(std::string_view name, size_t line_number);
+		/**
+		* Option inside the current section.
+		* @param name unescaped and validated option name
+		* @param values trimmed list items, still escaped (see string_utils::unescape)
+		* @param line_number number of line with option
+		*/
+		virtual void on_option(std::string_view name, const std::vector<std::string_view> &values, size_t line_number);
+		/**
+		* Comment, either on separate line or after section or option.
+		* @param comment text of comment without leading semicolon
+		* @param line_number number of line with comment
+		*/
+		virtual void on_comment(std::string_view comment, size_t line_number);
+		/**
+		* Another resource was included with #include directive. Lines of the
+		* included resource follow.
+		* @param resource_name name of included resource
+		*/
+		virtual void on_include(std::string_view resource_name);
+		/**
+		* Line which is not valid ini syntax. If handler does not throw,
+		* the line is skipped and parsing continues.
+		* @param message description of error including line number
+		* @param line_number number of erroneous line
+		* @throws parser_exception with given message by default
+		*/
+		virtual void on_error(const std::string &message, size_t line_number);
+	};
+
 	/**
 	* This is a common ancestor to classes file_fetcher and string_strema_fetcher.
 	* Hese classes allows to access to ifstream or stringstream uniformly.
 	*/
 	class resource
 	{
+	protected:
+		/** Handler which is notified about #include directives, nullptr if none. */
+		parse_handler *handler_ = nullptr;
+
 	public:
 		/**
 		* Virtual destructor supplied because the class is expected to be derived.
@@ -33,6 +89,15 @@ namespace inicpp
 		* @return true if successful, false if the end or other error was reached.
 		*/
 		virtual bool get_line(std::string &out_string) = 0;
+
+		/**
+		* Sets handler which is notified about included resources.
+		* @param handler event receiver or nullptr
+		*/
+		void set_handler(parse_handler *handler)
+		{
+			handler_ = handler;
+		}
 	};
 
 	/**
@@ -58,6 +123,32 @@ namespace inicpp
 		virtual bool get_line(std::string &out_string);
 	};
 
+	/**
+	* Lines of a buffer which is already in memory. Captures only a view,
+	* so the buffer has to outlive the resource.
+	*/
+	class buffer_resource : public resource
+	{
+	private:
+		/** Encapsulated buffer. */
+		std::string_view buffer_;
+		/** Offset of the first unread character. */
+		size_t position_;
+	public:
+		/** Initiliazes the resource with the specified buffer. */
+		buffer_resource(std::string_view buffer);
+
+		/*
+		* \copydoc resource::~resource()
+		*/
+		virtual ~buffer_resource() {};
+
+		/**
+		* \copydoc resource::get_line(std::string)
+		*/
+		virtual bool get_line(std::string &out_string);
+	};
+
 	/**
 	* Abstract class implementing the ability to include other resources using
 	* the #include directive.
@@ -138,12 +229,15 @@ namespace inicpp
 				} while (true);
 
 				// ignore whitespaces at the beginning
-				std::string line = left_trim(out_string);
+				std::string_view line = left_trim(std::string_view(out_string));
 				if (starts_with(line, "#include")) {
-					std::string resource_name = trim(line.substr(8)); // remove "#include "
+					std::string resource_name(trim(line.substr(8))); // remove "#include "
 
-																	  // retrieve the new current resource
+					// retrieve the new current resource
 					stack_.push(get_resource(resource_name));
+					if (this->handler_ != nullptr) {
+						this->handler_->on_include(resource_name);
+					}
 				}
 				else {
 					break;
@@ -155,23 +249,74 @@ namespace inicpp
 	};
 
 	/**
-	* The following classes are enabling us to work with files and prepared string_streams alike.
+	* Whole file made accessible in memory, either memory-mapped or read in one go
+	* on platforms without mmap. Lines are then found directly in the buffer,
+	* which avoids the per-line overhead of std::getline on std::ifstream.
 	*/
-	class file_resource_stack : public resource_stack<std::ifstream>
+	class INICPP_API mapped_file
 	{
 	private:
-		/** Returns ifstream corresponding to file with given name. */
-		static std::ifstream get_file_stream(const std::string &file_name);
+		/** Beginning of the file contents. */
+		const char *data_;
+		/** Size of the file contents in bytes. */
+		size_t size_;
+		/** Offset of the first unread character. */
+		size_t position_;
+		/** True if data_ points to mapped memory which has to be unmapped. */
+		bool mapped_;
+		/** Storage of the contents if the file could not be mapped. */
+		std::string buffer_;
+
+		/** Reads the whole file into buffer_, used when mapping is not possible. */
+		void read_whole_file(const std::string &file_name);
+		/** Unmaps the file if it was mapped. */
+		void release();
 
+	public:
+		/**
+		* Maps the file with given name into memory.
+		* @throws parser_exception if file cannot be opened
+		*/
+		mapped_file(const std::string &file_name);
+		/** Deleted copy constructor, the mapping cannot be shared. */
+		mapped_file(const mapped_file &source) = delete;
+		/** Deleted copy assignment, the mapping cannot be shared. */
+		mapped_file &operator=(const mapped_file &source) = delete;
+		/** Move constructor. */
+		mapped_file(mapped_file &&source);
+		/** Move assignment. */
+		mapped_file &operator=(mapped_file &&source);
+		/** Unmaps the file. */
+		~mapped_file();
+
+		/**
+		* Retrieves next line from the file, line ending is not included.
+		* @return true if successful, false if the end of file was reached.
+		*/
+		bool get_line(std::string &out_string);
+
+		/**
+		* Whole contents of the file, valid as long as this object lives.
+		*/
+		std::string_view contents() const;
+	};
+
+	/**
+	* The following classes are enabling us to work with files and prepared string_streams alike.
+	*/
+	class INICPP_API file_resource_stack : public resource_stack<mapped_file>
+	{
 	protected:
-		/** \copydoc file_resource_stack::get_file_stream(const std::string &file_name) */
-		virtual std::ifstream get_resource(const std::string &file_name);
+		/** Maps the file with given name, throws parser_exception if it cannot be opened. */
+		virtual mapped_file get_resource(const std::string &file_name);
 
 		/** \copydoc resource::get_line(std::string &out_string) */
-		virtual bool get_line(std::ifstream &resource, std::string &out_string) const;
+		virtual bool get_line(mapped_file &resource, std::string &out_string) const;
 
 	public:
 		file_resource_stack(const std::string& file_name);
+		/** Constructs the stack with already mapped file. */
+		file_resource_stack(mapped_file &&file);
 	};
 
 	namespace
@@ -251,7 +396,7 @@ namespace inicpp
 		stream_resource_stack(const std::string &initial_stream_name, const storage_map& streams)
 			: streams_(streams)
 		{
-			initialize(extractor::get_stream_from_map(streams_, initial_stream_name));
+			this->initialize(extractor::get_stream_from_map(streams_, initial_stream_name));
 		}
 
 		/*
@@ -268,26 +413,19 @@ namespace inicpp
 	class INICPP_API parser
 	{
 	private:
+		/** Consumer of parse events which builds config instance. */
+		class config_handler;
+		/** Consumer of parse events of one chunk in parallel loading. */
+		class chunk_handler;
+		/** Links collected during lexing, resolved when the whole config is known. */
+		class link_resolver;
+
 		/**
-		 * Finds first nonescaped character given as parameter
-		 * Escaping character is '\'
-		 * @return std::string::npos if not found
-		 */
-		static size_t find_first_nonescaped(const std::string &str, char ch);
-		/**
-		 * Finds last escaped character given as parameter
-		 * Escaping character is '\'
-		 * @return std::string::npos if not found
+		 * Splits option value into list items, items are trimmed but still escaped.
+		 * @param str option value
+		 * @param items output list, reused between calls
 		 */
-		static size_t find_last_escaped(const std::string &str, char ch);
-		static std::string unescape(const std::string &str);
-		static std::string delete_comment(const std::string &str);
-		static std::vector<std::string> parse_option_list(const std::string &str);
-		static void handle_links(const config &cfg,
-			const section &last_section,
-			std::vector<std::string> &option_val_list,
-			size_t line_number);
-		static void validate_identifier(const std::string &str, size_t line_number);
+		static void split_option_list(std::string_view str, std::vector<std::string_view> &items);
 
 		//static config internal_load(std::istream &str);
 		static void internal_save(const config &cfg, const schema &schm, std::ostream &str);
@@ -309,10 +447,31 @@ namespace inicpp
 		};
 		*/
 
+		/**
+		* Creates empty config with memory resource requested by options.
+		*/
+		static config create_config(const parser_options &options);
 		/**
 		* This internal_load which allows the #include functionality.
+		* Values of options in given schema are parsed into its types, config must not contain links then.
+		*/
+		static config internal_load(resource &res, const parser_options &options, const schema *schm = nullptr);
+		/**
+		* Loads configuration which is whole in memory, in parallel if requested by options.
+		* Values of options in given schema are parsed into its types, config must not contain links then.
+		*/
+		static config internal_load(
+			std::string_view buffer, const parser_options &options, const schema *schm = nullptr);
+		/**
+		* Splits buffer at section headers, parses chunks in parallel and merges them in order.
+		*/
+		static config parallel_load(
+			std::string_view buffer, size_t chunk_count, const parser_options &options, const schema *schm);
+		/**
+		* Implementation of parse(), line numbers start after given offset.
 		*/
-		static config parser::internal_load(resource &res);
+		static void internal_parse(
+			resource &res, parse_handler &handler, const parser_options &options, size_t line_offset);
 	public:
 		/**
 		 * Deleted default constructor.
@@ -335,82 +494,136 @@ namespace inicpp
 		 */
 		parser &operator=(parser &&source) = delete;
 
+		/**
+		 * Go through ini configuration from given resource and report found
+		 * elements to given handler. Nothing is stored, memory consumption
+		 * does not depend on size of the input.
+		 * @param res ini configuration resource
+		 * @param handler receiver of parse events
+		 * @param options parser settings
+		 * @throws parser_exception if ini configuration is wrong and handler does not override on_error
+		 */
+		static void parse(resource &res, parse_handler &handler, const parser_options &options = parser_options());
+		/**
+		 * Go through ini configuration from given stream and report found
+		 * elements to given handler.
+		 * @param str ini configuration description
+		 * @param handler receiver of parse events
+		 * @param options parser settings
+		 * @throws parser_exception if ini configuration is wrong and handler does not override on_error
+		 */
+		static void parse(std::istream &str, parse_handler &handler, const parser_options &options = parser_options());
+		/**
+		 * Go through ini configuration from given string and report found
+		 * elements to given handler.
+		 * @param str ini configuration description
+		 * @param handler receiver of parse events
+		 * @param options parser settings
+		 * @throws parser_exception if ini configuration is wrong and handler does not override on_error
+		 */
+		static void parse(
+			const std::string &str, parse_handler &handler, const parser_options &options = parser_options());
+		/**
+		 * Go through ini configuration in file with specified name and report
+		 * found elements to given handler.
+		 * @param file name of file which contains ini configuration
+		 * @param handler receiver of parse events
+		 * @param options parser settings
+		 * @throws parser_exception if ini configuration is wrong and handler does not override on_error
+		 */
+		static void parse_file(
+			const std::string &file, parse_handler &handler, const parser_options &options = parser_options());
+
 		/**
 		 * Load ini configuration from given string and return it.
 		 * @param str ini configuration description
+		 * @param options parser settings
 		 * @return newly created config class
 		 * @throws parser_exception if ini configuration is wrong
 		 */
-		static config load(const std::string &str);
+		static config load(const std::string &str, const parser_options &options = parser_options());
 		/**
 		 * Load ini configuration from given string
 		 * and validate it through schema.
 		 * @param str ini configuration description
 		 * @param schm validation schema
 		 * @param mode validation mode
+		 * @param options parser settings
 		 * @return constructed config class which comply given schema
 		 * @throws parser_exception if ini configuration is wrong
 		 * @throws validation_exception if configuration does not comply schema
 		 */
-		static config load(const std::string &str, const schema &schm, schema_mode mode);
+		static config load(
+			const std::string &str, const schema &schm, schema_mode mode, const parser_options &options = parser_options());
 		/**
 		 * Load ini configuration from given stream and return it.
 		 * @param str ini configuration description
+		 * @param options parser settings
 		 * @return newly created config class
 		 * @throws parser_exception if ini configuration is wrong
 		 */
-		static config load(std::istream &str);
+		static config load(std::istream &str, const parser_options &options = parser_options());
 		/**
 		 * Load ini configuration from given stream
 		 * and validate it through schema.
 		 * @param str ini configuration description
 		 * @param schm validation schema
 		 * @param mode validation mode
+		 * @param options parser settings
 		 * @return constructed config class which comply given schema
 		 * @throws parser_exception if ini configuration is wrong
 		 * @throws validation_exception if configuration does not comply schema
 		 */
-		static config load(std::istream &str, const schema &schm, schema_mode mode);
+		static config load(
+			std::istream &str, const schema &schm, schema_mode mode, const parser_options &options = parser_options());
 
 		/**
 		* Load in configuaration from sources stored in resource.
 		* @param res ini configuration resource
 		* @param res_fetcher resource fetcher to be used
+		* @param options parser settings
 		* @throws parser_exception if ini configuration is wrong
 		* @throws validation_exception if configuration does not comply schema
 		* @return new instance of config class
 		*/
-		static config load(resource &res);
+		static config load(resource &res, const parser_options &options = parser_options());
 		/**
 		* Load in configuaration from sources stored in resource.
 		* @param res ini configuration resource
 		* @param schm validation schema
 		* @param mode validation mode
 		* @param res_fetcher resource fetcher to be used
+		* @param options parser settings
 		* @throws parser_exception if ini configuration is wrong
 		* @throws validation_exception if configuration does not comply schema
 		* @return new instance of config class
 		*/
-		static config load(resource &res, const schema &schm, schema_mode mode);
+		static config load(
+			resource &res, const schema &schm, schema_mode mode, const parser_options &options = parser_options());
 
 		/**
 		 * Load ini configuration from file with specified name.
 		 * @param file name of file which contains ini configuration
+		 * @param options parser settings
 		 * @return new instance of config class
 		 * @throws parser_exception if ini configuration is wrong
 		 */
-		static config load_file(const std::string &file);
+		static config load_file(const std::string &file, const parser_options &options = parser_options());
 		/**
 		 * Load ini configuration from file with specified name
 		 * and validate it against given schema.
 		 * @param file name of file with ini configuration
 		 * @param schm validation schema
 		 * @param mode validation mode
+		 * @param options parser settings
 		 * @return new instance of config class
 		 * @throws parser_exception if ini configuration is wrong
 		 * @throws validation_exception if configuration does not comply schema
 		 */
-		static config load_file(const std::string &file, const schema &schm, schema_mode mode);
+		static config load_file(const std::string &file,
+			const schema &schm,
+			schema_mode mode,
+			const parser_options &options = parser_options());
 
 
 		/**
@@ -0,0 +1,126 @@
+#ifndef INICPP_PARSER_OPTIONS_H
+#define INICPP_PARSER_OPTIONS_H
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+
+
+namespace inicpp
+{
+	/**
+	 * Grammar of identifiers (section and option names) in the form of two
+	 * character class lookup tables. Tables are constructed at compile time
+	 * from regex-like character class specifications, so validation of
+	 * identifier is one pass over its characters without any allocation.
+	 */
+	class identifier_grammar
+	{
+	private:
+		/** Type of lookup table indexed by unsigned character */
+		using char_table = std::array<bool, 256>;
+
+		/** Characters allowed at the beginning of identifier */
+		char_table first_;
+		/** Characters allowed in the rest of identifier */
+		char_table rest_;
+
+		/**
+		 * Creates lookup table from character class specification.
+		 * Specification contains characters and ranges in the form "a-z",
+		 * minus sign at the beginning or at the end is taken literally.
+		 */
+		static constexpr char_table make_table(const char *spec)
+		{
+			char_table table{};
+			for (size_t i = 0; spec[i] != '\0'; ++i) {
+				if (spec[i + 1] == '-' && spec[i + 2] != '\0') {
+					// range of characters
+					for (unsigned ch = static_cast<unsigned char>(spec[i]); ch <= static_cast<unsigned char>(spec[i + 2]);
+						 ++ch) {
+						table[ch] = true;
+					}
+					i += 2;
+				} else {
+					table[static_cast<unsigned char>(spec[i])] = true;
+				}
+			}
+			return table;
+		}
+
+	public:
+		/**
+		 * Construct grammar from given character class specifications.
+		 * @param first_chars characters allowed at the beginning, eg. "a-zA-Z"
+		 * @param rest_chars characters allowed in the rest of identifier, eg. "-a-zA-Z0-9_"
+		 */
+		constexpr identifier_grammar(const char *first_chars, const char *rest_chars)
+			: first_(make_table(first_chars)), rest_(make_table(rest_chars))
+		{
+		}
+
+		/**
+		 * Default inicpp grammar equal to "^[a-zA-Z.$:][-a-zA-Z0-9_~.:$ ]*$".
+		 * @return grammar constructed at compile time
+		 */
+		static constexpr identifier_grammar standard()
+		{
+			return identifier_grammar("a-zA-Z.$:", "-a-zA-Z0-9_~.:$ ");
+		}
+
+		/**
+		 * Checks whether given identifier complies this grammar.
+		 * Empty identifier is never valid.
+		 * @param str validated identifier
+		 * @return true if identifier is valid
+		 */
+		constexpr bool is_valid(std::string_view str) const
+		{
+			if (str.empty() || !first_[static_cast<unsigned char>(str[0])]) {
+				return false;
+			}
+			for (size_t i = 1; i < str.length(); ++i) {
+				if (!rest_[static_cast<unsigned char>(str[i])]) {
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+
+
+	/**
+	 * Settings which can change behaviour of parser.
+	 * Default constructed instance gives standard inicpp behaviour.
+	 */
+	struct parser_options {
+		/** Grammar which section and option names have to comply */
+		identifier_grammar identifiers = identifier_grammar::standard();
+		/**
+		 * Number of threads used to load configuration which is whole in memory
+		 * (string or file), 0 means number of hardware threads. Input is split
+		 * at section headers and result is identical to loading by one thread.
+		 * Files with #include directives are always loaded by one thread.
+		 */
+		unsigned threads = 1;
+		/**
+		 * Allocate loaded config in arena. The whole tree of sections, options
+		 * and lists of values is placed in big blocks owned by the config, which
+		 * are freed at once with the config. Names and values are std::string,
+		 * so only strings longer than their inline buffer are allocated separately.
+		 * Config can be moved to other thread, but sections and options moved out
+		 * of it still use its memory and must not outlive it, copy them instead.
+		 */
+		bool use_arena = false;
+		/**
+		 * Memory resource from which the whole loaded config is allocated,
+		 * nullptr means default resource. Ignored if arena is used. Resource has
+		 * to outlive the config and with more threads it is used concurrently,
+		 * so it has to be synchronized, eg. std::pmr::synchronized_pool_resource.
+		 */
+		std::pmr::memory_resource *memory = nullptr;
+	};
+}
+
+#endif // INICPP_PARSER_OPTIONS_H
@@ -2,11 +2,17 @@
 #define INICPP_SCHEMA_H
 
 #include <iostream>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
 #include <vector>
 
+#include "compiled_schema.h"
 #include "config.h"
 #include "dll.h"
 #include "exception.h"
+#include "executor.h"
 #include "option_schema.h"
 #include "section_schema.h"
 
@@ -20,41 +26,94 @@ namespace inicpp
 	 * Represents base point of schema validation.
 	 * Object of config class is validated against this one.
 	 * Can contain schemes of sections and in them schemes for options.
+	 * Whole tree of section and option schemas is allocated from memory
+	 * resource given on construction, copies use default memory resource.
 	 */
 	class INICPP_API schema
 	{
 	private:
-		using sect_schema_vector = std::vector<std::shared_ptr<section_schema>>;
-		using sect_schema_map = std::map<std::string, std::shared_ptr<section_schema>>;
-		using sect_schema_map_pair = std::pair<std::string, std::shared_ptr<section_schema>>;
+		using sect_schema_vector = std::pmr::vector<std::shared_ptr<section_schema>>;
+		/** Keys are owned copies of names, stored section schemas can be renamed by assignment */
+		using sect_schema_map = std::pmr::map<std::pmr::string, std::shared_ptr<section_schema>, std::less<>>;
 
 		/** Container for section_schema objects */
 		sect_schema_vector sections_;
 		/** Map of section_schema object for better searching by name */
 		sect_schema_map sections_map_;
 
+		/**
+		 * Stores already allocated section schema into both containers.
+		 * @param sect section schema allocated by allocator of this instance
+		 */
+		void push_section(std::shared_ptr<section_schema> sect);
+		/**
+		 * Deep copies all section schemas of given schema into this instance.
+		 * @param source schema which sections are copied
+		 */
+		void copy_sections(const schema &source);
+		/**
+		 * Handles section schema which has no section in config. Optional section
+		 * is added to config with default values of all its options.
+		 * @param cfg validated configuration
+		 * @param sect schema of missing section
+		 * @throws validation_exception if section is mandatory
+		 */
+		static void add_missing_section(config &cfg, const section_schema &sect);
+		/**
+		 * In strict mode checks that there are no sections without schema in config.
+		 * @param cfg validated configuration
+		 * @param mode validation mode
+		 * @throws validation_exception if unknown section is found in strict mode
+		 */
+		void check_unknown_sections(const config &cfg, schema_mode mode) const;
+
 	public:
+		/** Type of allocator, which determines memory resource of the schema */
+		using allocator_type = std::pmr::polymorphic_allocator<char>;
+
 		/**
 		 * Default constructor.
 		 */
 		schema();
 		/**
-		 * Copy constructor.
+		 * Construct empty schema which allocates its tree by given allocator.
+		 * Memory resource has to outlive the schema.
+		 * @param alloc allocator of section and option schemas
+		 */
+		explicit schema(const allocator_type &alloc);
+		/**
+		 * Copy constructor, copy uses default memory resource.
 		 */
 		schema(const schema &source);
 		/**
-		 * Copy assignment.
+		 * Copy constructor with given allocator.
+		 */
+		schema(const schema &source, const allocator_type &alloc);
+		/**
+		 * Copy assignment, memory resource of this schema stays the same.
 		 */
 		schema &operator=(const schema &source);
 		/**
 		 * Move constructor.
 		 */
-		schema(schema &&source);
+		schema(schema &&source) noexcept;
 		/**
-		 * Move assignment.
+		 * Move constructor with given allocator,
+		 * section schemas are copied if allocators differ.
+		 */
+		schema(schema &&source, const allocator_type &alloc);
+		/**
+		 * Move assignment, memory resource of this schema stays the same,
+		 * so section schemas are copied if allocators differ.
 		 */
 		schema &operator=(schema &&source);
 
+		/**
+		 * Allocator of the tree of this schema.
+		 * @return copy of allocator
+		 */
+		allocator_type get_allocator() const;
+
 		/**
 		 * Adds section from given attribute to internal container.
 		 * @param sect_schema constant reference to section_schema object
@@ -88,7 +147,7 @@ namespace inicpp
 		template <typename ArgType>
 		void add_option(const std::string &section_name, option_schema_params<ArgType> &arguments)
 		{
-			auto sect_it = sections_map_.find(section_name);
+			auto sect_it = sections_map_.find(std::string_view(section_name));
 			if (sect_it != sections_map_.end()) {
 				option_schema opt_schema(arguments);
 				sect_it->second->add_option(opt_schema);
@@ -122,20 +181,27 @@ namespace inicpp
 		 * @return modifiable reference to stored section_schema
 		 * @throws not_found_exception if section_schema with given name does not exist
 		 */
-		section_schema &operator[](const std::string &section_name);
+		section_schema &operator[](std::string_view section_name);
 		/**
 		 * Access constant reference on section_schema with specified name.
 		 * @param section_name name of requested section_schema
 		 * @return constant reference to stored section_schema
 		 * @throws not_found_exception if section_schema with given name does not exist
 		 */
-		const section_schema &operator[](const std::string &section_name) const;
+		const section_schema &operator[](std::string_view section_name) const;
 		/**
 		 * Tries to find section_schema with specified name inside this config.
 		 * @param section_name name which is searched
 		 * @return true if section_schema with this name is present, false otherwise
 		 */
-		bool contains(const std::string &section_name) const;
+		bool contains(std::string_view section_name) const;
+		/**
+		 * Statistics of memoized validators of all option schemas in this schema.
+		 * Validator shared by several options is counted once, but its counters
+		 * include its use by all schemas which share it.
+		 * @return sum of counters of distinct caches
+		 */
+		memo_statistics get_memo_statistics() const;
 
 		/**
 		 * Validate cfg against this schema in specified mode.
@@ -144,6 +210,29 @@ namespace inicpp
 		 * @throws validation_exception if schema cannot be validated
 		 */
 		void validate_config(config &cfg, schema_mode mode) const;
+		/**
+		 * Validate cfg against this schema in specified mode, sections are validated
+		 * concurrently by given executor. Errors are collected and the first one
+		 * in the order of section schemas is reported, which is the same error
+		 * as in validation by one thread. Successfully validated config is changed
+		 * in the same way too, but config which fails differs: all present sections
+		 * are already validated and their options converted, including the ones
+		 * following the failed section, while missing sections following it are not added.
+		 * Validators of option schemas have to be callable concurrently and
+		 * memory resource of the config has to be synchronized. Config allocated
+		 * in arena is validated by the calling thread, because arena is not synchronized.
+		 * @param cfg configuration which will be validated
+		 * @param mode validation mode
+		 * @param exec executor which runs validation of sections
+		 * @throws validation_exception if schema cannot be validated
+		 */
+		void validate_config(config &cfg, schema_mode mode, executor &exec) const;
+		/**
+		 * Creates immutable validation plan of this schema, which validates
+		 * configs faster and can be shared by threads.
+		 * @return plan independent of this schema
+		 */
+		compiled_schema compile() const;
 
 		/**
 		 * Classic stream operator for printing this instance to output stream.
@@ -2,13 +2,17 @@
 #define INICPP_SECTION_H
 
 #include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <iterator>
-#include <map>
+#include <memory_resource>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 #include "dll.h"
 #include "exception.h"
+#include "name_index.h"
 #include "option.h"
 #include "section_schema.h"
 
@@ -23,56 +27,93 @@ namespace inicpp
 	/**
 	 * Represents section from ini format. Can contain multiple options.
 	 * Always should be in config container class.
+	 * Options are stored contiguously, so references to them are invalidated
+	 * by adding or removing options.
+	 * Options and their values are allocated from memory resource given
+	 * on construction, copies use default memory resource.
 	 */
 	class INICPP_API section
 	{
 	private:
-		using options_vector = std::vector<std::shared_ptr<option>>;
-		using options_map = std::map<std::string, std::shared_ptr<option>>;
-		using options_map_pair = std::pair<std::string, std::shared_ptr<option>>;
+		using options_vector = std::pmr::vector<option>;
 
 		/** List of options in this instance */
 		options_vector options_;
-		/** Map of options for better searching */
-		options_map options_map_;
+		/** Hash index of option names for better searching */
+		name_index index_;
 		/** Name of this section */
 		std::string name_;
 
+		/**
+		 * Finds position of option with given name.
+		 * @param option_name searched name
+		 * @param name_hash hash of searched name from name_index::hash()
+		 * @return position in options list or name_index::npos
+		 */
+		size_t find_option(std::string_view option_name, uint64_t name_hash) const;
+		/**
+		 * Appends option to options list and indexes it.
+		 * @param opt option which name is not in this section
+		 * @param name_hash hash of option name from name_index::hash()
+		 */
+		void push_option(option &&opt, uint64_t name_hash);
+
 		friend class section_iterator<option>;
 		friend class section_iterator<const option>;
+		friend class option_handle;
+		friend class config;
+		friend class config_builder;
 
 	public:
 		/** type of iterator */
 		using iterator = section_iterator<option>;
 		/** type of const iterator */
 		using const_iterator = section_iterator<const option>;
+		/** Type of allocator, which determines memory resource of the section */
+		using allocator_type = std::pmr::polymorphic_allocator<char>;
 
 		/**
 		 * Default constructor is deleted.
 		 */
 		section() = delete;
 		/**
-		 * Copy constructor.
+		 * Copy constructor, copy uses default memory resource.
 		 */
 		section(const section &source);
 		/**
-		 * Copy assignment.
+		 * Copy constructor with given allocator.
+		 */
+		section(const section &source, const allocator_type &alloc);
+		/**
+		 * Copy assignment, memory resource of this section stays the same.
 		 */
 		section &operator=(const section &source);
 		/**
 		 * Move constructor.
 		 */
-		section(section &&source);
+		section(section &&source) noexcept;
 		/**
-		 * Move assignment.
+		 * Move constructor with given allocator, options are copied if allocators differ.
+		 */
+		section(section &&source, const allocator_type &alloc);
+		/**
+		 * Move assignment, memory resource of this section stays the same,
+		 * so options are copied if allocators differ.
 		 */
 		section &operator=(section &&source);
 
 		/**
 		 * Construct instance of section class with given name.
 		 * @param name name of newly created section class
+		 * @param alloc allocator of options
 		 */
-		section(const std::string &name);
+		section(const std::string &name, const allocator_type &alloc = allocator_type());
+
+		/**
+		 * Allocator of options of this section.
+		 * @return copy of allocator
+		 */
+		allocator_type get_allocator() const;
 
 		/**
 		 * Getter for name of this section.
@@ -88,12 +129,11 @@ namespace inicpp
 		 */
 		template <typename ValueType> void add_option(const std::string &option_name, ValueType value)
 		{
-			auto add_it = options_map_.find(option_name);
-			if (add_it == options_map_.end()) {
-				std::shared_ptr<option> opt = std::make_shared<option>(option_name);
-				opt->set<ValueType>(value);
-				options_.push_back(opt);
-				options_map_.insert(options_map_pair(opt->get_name(), opt));
+			uint64_t name_hash = name_index::hash(option_name);
+			if (find_option(option_name, name_hash) == name_index::npos) {
+				option opt(option_name, "", options_.get_allocator());
+				opt.set<ValueType>(value);
+				push_option(std::move(opt), name_hash);
 			} else {
 				throw ambiguity_exception(option_name);
 			}
@@ -104,6 +144,12 @@ namespace inicpp
 		 * @throws ambiguity_exception if option with specified name exists
 		 */
 		void add_option(const option &opt);
+		/**
+		 * Add given option instance to options container without copying its values.
+		 * @param opt option which will be moved into the section
+		 * @throws ambiguity_exception if option with specified name exists
+		 */
+		void add_option(option &&opt);
 		/**
 		 * From list of options remove the one with specified name
 		 * @param option_name name of option which will be removed
@@ -136,20 +182,20 @@ namespace inicpp
 		 * @return modifiable reference to stored option
 		 * @throws not_found_exception if option with given name does not exist
 		 */
-		option &operator[](const std::string &option_name);
+		option &operator[](std::string_view option_name);
 		/**
 		 * Access constant reference on option with specified name
 		 * @param option_name
 		 * @return constant reference to stored option
 		 * @throws not_found_exception if option with given name does not exist
 		 */
-		const option &operator[](const std::string &option_name) const;
+		const option &operator[](std::string_view option_name) const;
 		/**
 		 * Tries to find option with specified name inside this section.
 		 * @param option_name name which is searched
 		 * @return true if option with this name is present, false otherwise
 		 */
-		bool contains(const std::string &option_name) const;
+		bool contains(std::string_view option_name) const;
 
 		/**
 		 * Validates this section agains given section_schema.
@@ -217,9 +263,8 @@ namespace inicpp
 	/**
 	 * Templated section iterator.
 	 * Templates provide const and non-const iterator in one implementation.
-	 * For easier implementation inheritance from std::iterator is used.
 	 */
-	template <typename Element> class section_iterator : public std::iterator<std::random_access_iterator_tag, Element>
+	template <typename Element> class section_iterator
 	{
 	private:
 		/** Reference to container which can be iterated */
@@ -228,8 +273,16 @@ namespace inicpp
 		size_t position_;
 
 	public:
-		using typename std::iterator<std::random_access_iterator_tag, Element>::reference;
-		using typename std::iterator<std::random_access_iterator_tag, Element>::pointer;
+		/** category of the iterator */
+		using iterator_category = std::random_access_iterator_tag;
+		/** type of iterated elements */
+		using value_type = std::remove_cv_t<Element>;
+		/** type of distance between iterators */
+		using difference_type = std::ptrdiff_t;
+		/** pointer to iterated element */
+		using pointer = Element *;
+		/** reference to iterated element */
+		using reference = Element &;
 
 		/**
 		 * Deleted default constructor.
@@ -314,7 +367,7 @@ namespace inicpp
 		 */
 		reference operator*()
 		{
-			return *container_.options_.at(position_);
+			return container_.options_.at(position_);
 		}
 
 		/**
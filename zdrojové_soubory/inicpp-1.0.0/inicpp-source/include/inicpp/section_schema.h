@@ -2,6 +2,10 @@
 #define INICPP_SECTION_SCHEMA_H
 
 #include <iostream>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
 #include <vector>
 
 #include "dll.h"
@@ -33,13 +37,15 @@ namespace inicpp
 	/**
 	 * In section_schema are defined rules which ini section should fulfil.
 	 * Section can be validated against section_schema objects.
+	 * Option schemas and containers of them are allocated from memory resource
+	 * given on construction, copies use default memory resource.
 	 */
 	class INICPP_API section_schema
 	{
 	private:
-		using opt_schema_vector = std::vector<std::shared_ptr<option_schema>>;
-		using opt_schema_map = std::map<std::string, std::shared_ptr<option_schema>>;
-		using opt_schema_map_pair = std::pair<std::string, std::shared_ptr<option_schema>>;
+		using opt_schema_vector = std::pmr::vector<std::shared_ptr<option_schema>>;
+		/** Keys are owned copies of names, stored option schemas can be renamed by assignment */
+		using opt_schema_map = std::pmr::map<std::pmr::string, std::shared_ptr<option_schema>, std::less<>>;
 
 		/** Section name */
 		std::string name_;
@@ -53,33 +59,64 @@ namespace inicpp
 		/** Options stored in map for better searching */
 		opt_schema_map options_map_;
 
+		/**
+		 * Stores already allocated option schema into both containers.
+		 * @param opt option schema allocated by allocator of this instance
+		 */
+		void push_option(std::shared_ptr<option_schema> opt);
+		/**
+		 * Deep copies all option schemas of given section schema into this instance.
+		 * @param source section schema which options are copied
+		 */
+		void copy_options(const section_schema &source);
+
 	public:
+		/** Type of allocator, which determines memory resource of the section schema */
+		using allocator_type = std::pmr::polymorphic_allocator<char>;
+
 		/**
 		 * Default constructor is deleted.
 		 */
 		section_schema() = delete;
 		/**
-		 * Copy constructor.
+		 * Copy constructor, copy uses default memory resource.
 		 */
 		section_schema(const section_schema &source);
 		/**
-		 * Copy assignment.
+		 * Copy constructor with given allocator.
+		 */
+		section_schema(const section_schema &source, const allocator_type &alloc);
+		/**
+		 * Copy assignment, memory resource of this section schema stays the same.
 		 */
 		section_schema &operator=(const section_schema &source);
 		/**
 		 * Move constructor.
 		 */
-		section_schema(section_schema &&source);
+		section_schema(section_schema &&source) noexcept;
 		/**
-		 * Move assignment.
+		 * Move constructor with given allocator,
+		 * option schemas are copied if allocators differ.
+		 */
+		section_schema(section_schema &&source, const allocator_type &alloc);
+		/**
+		 * Move assignment, memory resource of this section schema stays the same,
+		 * so option schemas are copied if allocators differ.
 		 */
 		section_schema &operator=(section_schema &&source);
 
 		/**
 		 * Construct section_schema from given arguments.
 		 * @param arguments creation parameters
+		 * @param alloc allocator of option schemas
+		 */
+		section_schema(const section_schema_params &arguments, const allocator_type &alloc = allocator_type());
+
+		/**
+		 * Allocator of option schemas of this instance.
+		 * @return copy of allocator
 		 */
-		section_schema(const section_schema_params &arguments);
+		allocator_type get_allocator() const;
 
 		/**
 		 * Gets name of section.
@@ -110,11 +147,10 @@ namespace inicpp
 		 */
 		template <typename ArgType> void add_option(const option_schema_params<ArgType> &arguments)
 		{
-			auto add_it = options_map_.find(arguments.name);
+			auto add_it = options_map_.find(std::string_view(arguments.name));
 			if (add_it == options_map_.end()) {
-				std::shared_ptr<option_schema> add = std::make_shared<option_schema>(arguments);
-				options_.push_back(add);
-				options_map_.insert(opt_schema_map_pair(add->get_name(), add));
+				push_option(std::allocate_shared<option_schema>(
+					std::pmr::polymorphic_allocator<option_schema>(get_allocator()), arguments));
 			} else {
 				throw ambiguity_exception(arguments.name);
 			}
@@ -151,20 +187,33 @@ namespace inicpp
 		 * @return modifiable reference to stored option_schema
 		 * @throws not_found_exception if option_schema with given name does not exist
 		 */
-		option_schema &operator[](const std::string &option_name);
+		option_schema &operator[](std::string_view option_name);
 		/**
 		 * Access constant reference on option_schema with specified name
 		 * @param option_name
 		 * @return constant reference to stored option_schema
 		 * @throws not_found_exception if option_schema with given name does not exist
 		 */
-		const option_schema &operator[](const std::string &option_name) const;
+		const option_schema &operator[](std::string_view option_name) const;
 		/**
 		 * Tries to find option_schema with specified name inside this section.
 		 * @param option_name name which is searched
 		 * @return true if option_schema with this name is present, false otherwise
 		 */
-		bool contains(const std::string &option_name) const;
+		bool contains(std::string_view option_name) const;
+		/**
+		 * Statistics of memoized validators of all option schemas in this section.
+		 * Validator shared by several options is counted once, but its counters
+		 * include its use by all schemas which share it.
+		 * @return sum of counters of distinct caches
+		 */
+		memo_statistics get_memo_statistics() const;
+		/**
+		 * Adds statistics of memoized validators of all option schemas in this section
+		 * to given caches, caches which are already there are skipped.
+		 * @param caches counters of already collected caches
+		 */
+		void collect_memo_statistics(memo_caches &caches) const;
 
 		/**
 		 * Validate given section againts this section_schema.
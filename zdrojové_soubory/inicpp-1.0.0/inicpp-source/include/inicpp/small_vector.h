@@ -0,0 +1,375 @@
+#ifndef INICPP_SMALL_VECTOR_H
+#define INICPP_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+
+namespace inicpp
+{
+	/**
+	 * Sequence container which stores up to N elements inside the object
+	 * itself and only bigger lists in heap buffer. Used for option values,
+	 * which are mostly single values or short lists, so they need no
+	 * allocation. Iterators are plain pointers, they are invalidated
+	 * by every insertion and erasure.
+	 * Element type has to have move constructor which does not throw.
+	 * Heap buffers are taken from the allocator, which is chosen on construction
+	 * and never replaced by assignment, like with polymorphic allocators.
+	 */
+	template <typename T, size_t N, typename Allocator = std::allocator<T>> class small_vector
+	{
+	private:
+		static_assert(N > 0, "Inline capacity has to be positive");
+
+		using allocator_traits = std::allocator_traits<Allocator>;
+
+		union {
+			/** Storage of elements while capacity is N */
+			alignas(T) unsigned char inline_[N * sizeof(T)];
+			/** Heap buffer of elements while capacity is bigger than N */
+			T *heap_;
+		};
+		/** Number of stored elements */
+		uint32_t size_;
+		/** Number of elements which fit into current storage */
+		uint32_t capacity_;
+		/** Allocator of heap buffers */
+		Allocator allocator_;
+
+		bool is_inline() const
+		{
+			return capacity_ == N;
+		}
+
+		/** Moves elements to heap buffer of given capacity */
+		void reallocate(size_t capacity)
+		{
+			T *buffer = allocator_traits::allocate(allocator_, capacity);
+			T *old = data();
+			for (uint32_t i = 0; i < size_; ++i) {
+				new (buffer + i) T(std::move(old[i]));
+				old[i].~T();
+			}
+			if (!is_inline()) {
+				allocator_traits::deallocate(allocator_, heap_, capacity_);
+			}
+			heap_ = buffer;
+			capacity_ = static_cast<uint32_t>(capacity);
+		}
+
+		/**
+		 * Takes elements of source, which is left empty. This container has to be empty.
+		 * Heap buffer is taken only if allocators are equal, otherwise elements are moved.
+		 */
+		void steal(small_vector &source)
+		{
+			if (source.is_inline() || allocator_ != source.allocator_) {
+				reserve(source.size_);
+				T *from = source.data();
+				for (uint32_t i = 0; i < source.size_; ++i) {
+					new (data() + i) T(std::move(from[i]));
+				}
+				size_ = source.size_;
+				source.clear();
+			} else {
+				heap_ = source.heap_;
+				size_ = source.size_;
+				capacity_ = source.capacity_;
+				source.size_ = 0;
+				source.capacity_ = N;
+			}
+		}
+
+		/** Destroys elements and returns to inline storage */
+		void release() noexcept
+		{
+			clear();
+			if (!is_inline()) {
+				allocator_traits::deallocate(allocator_, heap_, capacity_);
+				capacity_ = N;
+			}
+		}
+
+	public:
+		/** Type of iterator */
+		using iterator = T *;
+		/** Type of constant iterator */
+		using const_iterator = const T *;
+
+		/** Type of allocator */
+		using allocator_type = Allocator;
+
+		/**
+		 * Construct empty container.
+		 * @param allocator allocator of heap buffers
+		 */
+		explicit small_vector(const Allocator &allocator = Allocator()) : size_(0), capacity_(N), allocator_(allocator)
+		{
+		}
+		/**
+		 * Construct container with copies of elements in given range.
+		 * @param first beginning of the range
+		 * @param last end of the range
+		 * @param allocator allocator of heap buffers
+		 */
+		template <typename InputIterator>
+		small_vector(InputIterator first, InputIterator last, const Allocator &allocator = Allocator())
+			: small_vector(allocator)
+		{
+			reserve(std::distance(first, last));
+			for (; first != last; ++first) {
+				push_back(*first);
+			}
+		}
+		/**
+		 * Copy constructor, allocator is selected by allocator traits.
+		 */
+		small_vector(const small_vector &source)
+			: small_vector(source, allocator_traits::select_on_container_copy_construction(source.allocator_))
+		{
+		}
+		/**
+		 * Copy constructor with given allocator.
+		 */
+		small_vector(const small_vector &source, const Allocator &allocator)
+			: small_vector(source.begin(), source.end(), allocator)
+		{
+		}
+		/**
+		 * Move constructor, source is left empty.
+		 */
+		small_vector(small_vector &&source) noexcept : size_(0), capacity_(N), allocator_(source.allocator_)
+		{
+			steal(source);
+		}
+		/**
+		 * Move constructor with given allocator, heap buffer of source
+		 * is taken only if allocators are equal. Source is left empty.
+		 */
+		small_vector(small_vector &&source, const Allocator &allocator) : size_(0), capacity_(N), allocator_(allocator)
+		{
+			steal(source);
+		}
+		/**
+		 * Copy assignment, allocator stays the same.
+		 */
+		small_vector &operator=(const small_vector &source)
+		{
+			if (this != &source) {
+				clear();
+				reserve(source.size_);
+				for (const T &item : source) {
+					push_back(item);
+				}
+			}
+			return *this;
+		}
+		/**
+		 * Move assignment, allocator stays the same, so heap buffer of source
+		 * is taken only if allocators are equal. Source is left empty.
+		 */
+		small_vector &operator=(small_vector &&source) noexcept(allocator_traits::is_always_equal::value)
+		{
+			if (this != &source) {
+				release();
+				steal(source);
+			}
+			return *this;
+		}
+		/**
+		 * Destroys elements and frees heap buffer.
+		 */
+		~small_vector()
+		{
+			release();
+		}
+
+		/**
+		 * Number of stored elements.
+		 * @return unsigned integer
+		 */
+		size_t size() const
+		{
+			return size_;
+		}
+		/**
+		 * Determines if there are no elements.
+		 * @return true if container is empty
+		 */
+		bool empty() const
+		{
+			return size_ == 0;
+		}
+		/**
+		 * Number of elements which can be stored without reallocation.
+		 * @return unsigned integer
+		 */
+		size_t capacity() const
+		{
+			return capacity_;
+		}
+		/**
+		 * Allocator of heap buffers.
+		 * @return copy of allocator
+		 */
+		Allocator get_allocator() const
+		{
+			return allocator_;
+		}
+
+		/**
+		 * Pointer to the first element.
+		 * @return pointer to contiguous elements
+		 */
+		T *data()
+		{
+			return is_inline() ? std::launder(reinterpret_cast<T *>(inline_)) : heap_;
+		}
+		/**
+		 * Pointer to the first element.
+		 * @return pointer to contiguous constant elements
+		 */
+		const T *data() const
+		{
+			return is_inline() ? std::launder(reinterpret_cast<const T *>(inline_)) : heap_;
+		}
+
+		iterator begin()
+		{
+			return data();
+		}
+		iterator end()
+		{
+			return data() + size_;
+		}
+		const_iterator begin() const
+		{
+			return data();
+		}
+		const_iterator end() const
+		{
+			return data() + size_;
+		}
+
+		/**
+		 * Access element on given position without range check.
+		 * @param position index of element
+		 * @return reference to element
+		 */
+		T &operator[](size_t position)
+		{
+			return data()[position];
+		}
+		/**
+		 * Access element on given position without range check.
+		 * @param position index of element
+		 * @return constant reference to element
+		 */
+		const T &operator[](size_t position) const
+		{
+			return data()[position];
+		}
+
+		/**
+		 * Makes room for given number of elements.
+		 * @param capacity requested capacity
+		 */
+		void reserve(size_t capacity)
+		{
+			if (capacity > capacity_) {
+				reallocate(capacity);
+			}
+		}
+
+		/**
+		 * Appends element at the end, spills to heap if inline storage is full.
+		 * @param value appended element
+		 */
+		void push_back(T value)
+		{
+			if (size_ == capacity_) {
+				reallocate(capacity_ * 2);
+			}
+			new (data() + size_) T(std::move(value));
+			++size_;
+		}
+
+		/**
+		 * Inserts element before given position.
+		 * @param position iterator to this container
+		 * @param value inserted element
+		 * @return iterator to inserted element
+		 */
+		iterator insert(const_iterator position, T value)
+		{
+			size_t index = position - begin();
+			if (index == size_) {
+				push_back(std::move(value));
+				return end() - 1;
+			}
+			if (size_ == capacity_) {
+				reallocate(capacity_ * 2);
+			}
+			T *items = data();
+			new (items + size_) T(std::move(items[size_ - 1]));
+			std::move_backward(items + index, items + size_ - 1, items + size_);
+			items[index] = std::move(value);
+			++size_;
+			return items + index;
+		}
+
+		/**
+		 * Removes element on given position.
+		 * @param position iterator to element of this container
+		 * @return iterator to the element which followed removed one
+		 */
+		iterator erase(const_iterator position)
+		{
+			size_t index = position - begin();
+			T *items = data();
+			std::move(items + index + 1, items + size_, items + index);
+			items[size_ - 1].~T();
+			--size_;
+			return items + index;
+		}
+
+		/**
+		 * Destroys all elements, capacity stays the same.
+		 */
+		void clear() noexcept
+		{
+			T *items = data();
+			for (uint32_t i = 0; i < size_; ++i) {
+				items[i].~T();
+			}
+			size_ = 0;
+		}
+
+		/**
+		 * Equality operator, compares elements.
+		 * @param other
+		 * @return true if containers have equal elements
+		 */
+		bool operator==(const small_vector &other) const
+		{
+			return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+		}
+		/**
+		 * Inequality operator.
+		 * @param other
+		 * @return true if containers differ
+		 */
+		bool operator!=(const small_vector &other) const
+		{
+			return !(*this == other);
+		}
+	};
+}
+
+#endif // INICPP_SMALL_VECTOR_H
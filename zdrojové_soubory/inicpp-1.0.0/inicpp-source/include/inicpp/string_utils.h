@@ -7,6 +7,7 @@
 #include <cctype>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace inicpp
@@ -35,27 +36,98 @@ namespace inicpp
 		 * @return newly created instance of string
 		 */
 		std::string trim(const std::string &str);
+		/**
+		 * Trim whitespaces from start of given string view.
+		 * @param str processed string
+		 * @return view into the same buffer as @a str, no allocation is done
+		 */
+		std::string_view left_trim(std::string_view str);
+		/**
+		 * Trim whitespaces from end of given string view.
+		 * @param str processed string
+		 * @return view into the same buffer as @a str, no allocation is done
+		 */
+		std::string_view right_trim(std::string_view str);
+		/**
+		 * Trim whitespaces from start and end of given string view.
+		 * @param str processed string
+		 * @return view into the same buffer as @a str, no allocation is done
+		 */
+		std::string_view trim(std::string_view str);
 		/**
 		 * In @a haystack find any occurence of needle.
 		 * @param haystack string in which search is executed
 		 * @param needle string which is searched for
 		 * @return true if at least one @a needle was found, false otherwise
 		 */
-		bool find_needle(const std::string &haystack, const std::string &needle);
+		bool find_needle(std::string_view haystack, std::string_view needle);
 		/**
 		 * Tries to find out if given @a str starts with @a search_str.
 		 * @param str searched string
 		 * @param search_str string which is searched for
 		 * @return true if given string starts with @a search_str
 		 */
-		bool starts_with(const std::string &str, const std::string &search_str);
+		bool starts_with(std::string_view str, std::string_view search_str);
 		/**
 		 * Tries to find out if given @a str ends with @a search_str.
 		 * @param str searched string
 		 * @param search_str string which is searched for
 		 * @return true if given string starts with @a search_str
 		 */
-		bool ends_with(const std::string &str, const std::string &search_str);
+		bool ends_with(std::string_view str, std::string_view search_str);
+		/**
+		 * Finds first nonescaped occurence of given character.
+		 * Escaping character is '\'. Long strings are scanned in 64 byte
+		 * blocks using SSE2 or AVX2 (chosen at runtime) where available.
+		 * @param str searched string
+		 * @param ch searched character, cannot be '\'
+		 * @return std::string::npos if not found
+		 */
+		size_t find_first_nonescaped(std::string_view str, char ch);
+		/**
+		 * Finds last escaped occurence of given character.
+		 * Escaping character is '\'. Long strings are scanned in 64 byte
+		 * blocks using SSE2 or AVX2 (chosen at runtime) where available.
+		 * @param str searched string
+		 * @param ch searched character
+		 * @return std::string::npos if not found
+		 */
+		size_t find_last_escaped(std::string_view str, char ch);
+		/**
+		 * Removes escaping characters from given string and appends the result
+		 * to @a out. Runs in linear time, output is allocated once and string
+		 * without any escaping character is copied at once.
+		 * @param str escaped string
+		 * @param out output buffer, its previous contents are kept
+		 */
+		void unescape(std::string_view str, std::string &out);
+		/**
+		 * Removes escaping characters from given string.
+		 * @param str escaped string
+		 * @return newly created unescaped string
+		 */
+		std::string unescape(std::string_view str);
+		/**
+		 * Escapes characters of given value which have special meaning in ini
+		 * format (escaping character, list delimiters, comment start and
+		 * whitespaces at the beginning and the end), so that the value can be
+		 * read back by parser. Result is appended to @a out in linear time.
+		 * @param str raw value
+		 * @param out output buffer, its previous contents are kept
+		 */
+		void escape(std::string_view str, std::string &out);
+		/**
+		 * Escapes given value, see escape(std::string_view, std::string &).
+		 * @param str raw value
+		 * @return newly created escaped string
+		 */
+		std::string escape(std::string_view str);
+		/**
+		 * Text of boolean value in the format of written options.
+		 * @param value formatted value
+		 * @return "yes" or "no"
+		 */
+		const char *format_boolean(boolean_ini_t value);
 		/**
 		 * Split given string with given delimiter.
 		 * @param str text which will be splitted
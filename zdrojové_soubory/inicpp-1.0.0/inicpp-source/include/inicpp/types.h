@@ -371,7 +371,7 @@ namespace inicpp
 	 * is returned.
 	 * @return enum representation of templated type
 	 */
-	template <typename ValueType> option_type get_option_enum_type()
+	template <typename ValueType> constexpr option_type get_option_enum_type()
 	{
 		if (std::is_same<ValueType, boolean_ini_t>::value) {
 			return option_type::boolean_e;
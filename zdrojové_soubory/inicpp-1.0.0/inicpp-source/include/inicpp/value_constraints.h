@@ -0,0 +1,403 @@
+#ifndef INICPP_VALUE_CONSTRAINTS_H
+#define INICPP_VALUE_CONSTRAINTS_H
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <regex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "exception.h"
+#include "string_utils.h"
+#include "types.h"
+#include "value_view.h"
+
+
+namespace inicpp
+{
+	/**
+	 * Order which values of list have to follow.
+	 */
+	enum class list_order : char { any, ascending, strictly_ascending, descending, strictly_descending };
+
+
+	/**
+	 * Declarative constraints of option values, alternative to opaque validator
+	 * functions. Constraints are checked for all values of an option at once
+	 * over their contiguous storage, checks of numeric values contain no branches,
+	 * so they can be vectorized by the compiler. Constraints are written with the
+	 * schema and can be copied freely, copies share the compiled pattern.
+	 * Setters return reference to the constraints, so they can be chained.
+	 */
+	template <typename ValueType> class value_constraints
+	{
+	private:
+		/** Lowest allowed value, none if there is no lower bound */
+		std::optional<ValueType> min_;
+		/** Highest allowed value, none if there is no upper bound */
+		std::optional<ValueType> max_;
+		/** Sorted allowed values without duplicates, empty if any value is allowed */
+		std::vector<ValueType> allowed_;
+		/** Lowest allowed length of textual value */
+		size_t min_length_ = 0;
+		/** Highest allowed length of textual value */
+		size_t max_length_ = std::numeric_limits<size_t>::max();
+		/** Source of pattern which textual values have to match, empty if there is none */
+		std::string pattern_source_;
+		/** Pattern compiled once and shared by all copies */
+		std::shared_ptr<const std::regex> pattern_;
+		/** Required order of list values */
+		list_order order_ = list_order::any;
+		/** Determines whether values of list have to be distinct */
+		bool unique_ = false;
+
+		/** Determines whether values are plain numbers, which are checked without branches */
+		static constexpr bool is_numeric = std::is_arithmetic<ValueType>::value;
+		/** Determines whether values are strings and textual constraints apply to them */
+		static constexpr bool is_textual =
+			std::is_same<ValueType, string_ini_t>::value || std::is_same<ValueType, enum_ini_t>::value;
+		/** Lists shorter than this are checked for duplicates by comparing each pair */
+		static constexpr size_t unique_pairs_limit = 16;
+
+		/**
+		 * Determines whether predicate holds for all indexes lower than count.
+		 * Numeric values are checked without early exit, so the loop can be vectorized.
+		 */
+		template <typename Predicate> static bool all_of(size_t count, Predicate pred)
+		{
+			if constexpr (is_numeric) {
+				// integer accumulator, reduction of bools is not recognized by vectorizers
+				unsigned result = 1;
+				for (size_t i = 0; i < count; ++i) {
+					result &= static_cast<unsigned>(pred(i));
+				}
+				return result != 0;
+			} else {
+				for (size_t i = 0; i < count; ++i) {
+					if (!pred(i)) {
+						return false;
+					}
+				}
+				return true;
+			}
+		}
+
+		/** Determines whether value is NaN, which is not equal to any value and cannot be sorted */
+		static bool is_nan(const ValueType &value)
+		{
+			if constexpr (std::is_floating_point<ValueType>::value) {
+				return std::isnan(value);
+			} else {
+				return false;
+			}
+		}
+
+		/** Text of textual value */
+		static const std::string &text_of(const ValueType &value, std::string &buffer)
+		{
+			if constexpr (std::is_same<ValueType, enum_ini_t>::value) {
+				buffer = static_cast<std::string>(value);
+				return buffer;
+			} else {
+				return value;
+			}
+		}
+
+		/** Determines whether values are in the required order */
+		bool check_order(const ValueType *values, size_t count) const
+		{
+			if (count < 2) {
+				return true;
+			}
+			switch (order_) {
+			case list_order::ascending:
+				return all_of(count - 1, [values](size_t i) { return !(values[i + 1] < values[i]); });
+			case list_order::strictly_ascending:
+				return all_of(count - 1, [values](size_t i) { return values[i] < values[i + 1]; });
+			case list_order::descending:
+				return all_of(count - 1, [values](size_t i) { return !(values[i] < values[i + 1]); });
+			case list_order::strictly_descending:
+				return all_of(count - 1, [values](size_t i) { return values[i + 1] < values[i]; });
+			case list_order::any: break;
+			}
+			return true;
+		}
+
+		/** Determines whether values are distinct */
+		static bool check_unique(const ValueType *values, size_t count)
+		{
+			if (count < unique_pairs_limit) {
+				for (size_t i = 1; i < count; ++i) {
+					for (size_t j = 0; j < i; ++j) {
+						if (values[i] == values[j]) {
+							return false;
+						}
+					}
+				}
+				return true;
+			}
+			// NaN differs from all values as in the comparison of pairs, so it is left out of sorting
+			std::vector<ValueType> sorted;
+			sorted.reserve(count);
+			std::remove_copy_if(values, values + count, std::back_inserter(sorted), is_nan);
+			std::sort(sorted.begin(), sorted.end());
+			return std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end();
+		}
+
+		/** Writes value in the format of option values */
+		static void write_value(std::ostream &os, const ValueType &value)
+		{
+			if constexpr (std::is_same<ValueType, boolean_ini_t>::value) {
+				os << string_utils::format_boolean(value);
+			} else if constexpr (is_numeric) {
+				os << value;
+			} else if constexpr (is_textual) {
+				std::string buffer;
+				os << string_utils::escape(text_of(value, buffer));
+			} else if constexpr (std::is_same<ValueType, date_ini_t>::value) {
+				os << std::put_time(&value.as_tm(), date_ini_t::DATE_FORMAT_STRING);
+			} else {
+				os << string_utils::escape(value.name());
+			}
+		}
+
+	public:
+		/**
+		 * Allows only values in given closed interval.
+		 * @param min lowest allowed value
+		 * @param max highest allowed value
+		 * @return reference to these constraints
+		 */
+		value_constraints &range(const ValueType &min, const ValueType &max)
+		{
+			min_ = min;
+			max_ = max;
+			return *this;
+		}
+		/**
+		 * Allows only values which are not lower than given one.
+		 * @param min lowest allowed value
+		 * @return reference to these constraints
+		 */
+		value_constraints &at_least(const ValueType &min)
+		{
+			min_ = min;
+			return *this;
+		}
+		/**
+		 * Allows only values which are not higher than given one.
+		 * @param max highest allowed value
+		 * @return reference to these constraints
+		 */
+		value_constraints &at_most(const ValueType &max)
+		{
+			max_ = max;
+			return *this;
+		}
+		/**
+		 * Allows only values from given set.
+		 * @param values allowed values, duplicates and NaN which equals no value are ignored
+		 * @return reference to these constraints
+		 */
+		value_constraints &one_of(std::vector<ValueType> values)
+		{
+			values.erase(std::remove_if(values.begin(), values.end(), is_nan), values.end());
+			std::sort(values.begin(), values.end());
+			values.erase(std::unique(values.begin(), values.end()), values.end());
+			allowed_ = std::move(values);
+			return *this;
+		}
+		/**
+		 * Allows only textual values with length in given closed interval.
+		 * @param min lowest allowed length
+		 * @param max highest allowed length
+		 * @return reference to these constraints
+		 */
+		value_constraints &length(size_t min, size_t max = std::numeric_limits<size_t>::max())
+		{
+			static_assert(is_textual, "Length can be constrained only for strings and enums");
+			min_length_ = min;
+			max_length_ = max;
+			return *this;
+		}
+		/**
+		 * Allows only textual values which match given ECMAScript regular expression as a whole.
+		 * Pattern is compiled here, once for all copies of the constraints.
+		 * @param pattern regular expression
+		 * @return reference to these constraints
+		 * @throws invalid_type_exception if pattern has bad format
+		 */
+		value_constraints &matches(const std::string &pattern)
+		{
+			static_assert(is_textual, "Pattern can be matched only by strings and enums");
+			try {
+				pattern_ = std::make_shared<const std::regex>(pattern, std::regex::ECMAScript | std::regex::optimize);
+			} catch (const std::regex_error &e) {
+				throw invalid_type_exception("Invalid pattern '" + pattern + "': " + e.what());
+			}
+			pattern_source_ = pattern;
+			return *this;
+		}
+		/**
+		 * Requires values of list to be in given order.
+		 * @param order required order
+		 * @return reference to these constraints
+		 */
+		value_constraints &ordered(list_order order)
+		{
+			order_ = order;
+			return *this;
+		}
+		/**
+		 * Requires values of list to be distinct.
+		 * @return reference to these constraints
+		 */
+		value_constraints &unique()
+		{
+			unique_ = true;
+			return *this;
+		}
+
+		/**
+		 * Determines whether no constraint is set.
+		 * @return true if all values are allowed
+		 */
+		bool empty() const
+		{
+			return !min_ && !max_ && allowed_.empty() && min_length_ == 0 &&
+				max_length_ == std::numeric_limits<size_t>::max() && !pattern_ && order_ == list_order::any && !unique_;
+		}
+
+		/**
+		 * Checks all given values at once.
+		 * @param values contiguous values of one option
+		 * @param option_name name of the option used in error messages
+		 * @throws validation_exception if some constraint is not satisfied
+		 */
+		void validate(value_view<ValueType> values, const std::string &option_name) const
+		{
+			const ValueType *data = values.data();
+			size_t count = values.size();
+			auto fail = [&option_name](const std::string &reason) {
+				throw validation_exception("Option '" + option_name + "' - " + reason);
+			};
+
+			if (min_ || max_) {
+				bool in_range;
+				if constexpr (is_numeric) {
+					// both bounds are always compared, which keeps the loop free of branches,
+					// missing bound of floating point values is infinite, so it allows infinity too
+					using limits = std::numeric_limits<ValueType>;
+					ValueType low = min_ ? *min_ : (limits::has_infinity ? -limits::infinity() : limits::lowest());
+					ValueType high = max_ ? *max_ : (limits::has_infinity ? limits::infinity() : limits::max());
+					in_range = all_of(count, [data, low, high](size_t i) { return (data[i] >= low) & (data[i] <= high); });
+				} else {
+					in_range = all_of(count, [this, data](size_t i) {
+						return !(min_ && data[i] < *min_) && !(max_ && *max_ < data[i]);
+					});
+				}
+				if (!in_range) {
+					fail("value out of range");
+				}
+			}
+			if (!allowed_.empty()) {
+				auto is_allowed = [this, data](size_t i) {
+					return !is_nan(data[i]) && std::binary_search(allowed_.begin(), allowed_.end(), data[i]);
+				};
+				if (!all_of(count, is_allowed)) {
+					fail("value is not one of allowed values");
+				}
+			}
+			if constexpr (is_textual) {
+				std::string buffer;
+				for (size_t i = 0; i < count; ++i) {
+					const std::string &text = text_of(data[i], buffer);
+					if (text.length() < min_length_ || text.length() > max_length_) {
+						fail("value length out of range");
+					}
+					if (pattern_ && !std::regex_match(text, *pattern_)) {
+						fail("value does not match pattern");
+					}
+				}
+			}
+			if (!check_order(data, count)) {
+				fail("values are not in required order");
+			}
+			if (unique_ && !check_unique(data, count)) {
+				fail("values are not unique");
+			}
+		}
+
+		/**
+		 * Writes constraints in human readable form, which is used in comments of saved schema.
+		 * Nothing is written if there is no constraint.
+		 * @param os output stream
+		 * @return reference to output stream for better chaining
+		 */
+		std::ostream &write(std::ostream &os) const
+		{
+			const char *separator = "";
+			auto next = [&os, &separator]() -> std::ostream & {
+				os << separator;
+				separator = ", ";
+				return os;
+			};
+
+			if (min_ || max_) {
+				next() << "range ";
+				if (min_) {
+					os << "[";
+					write_value(os, *min_);
+				} else {
+					os << "(";
+				}
+				os << ", ";
+				if (max_) {
+					write_value(os, *max_);
+					os << "]";
+				} else {
+					os << ")";
+				}
+			}
+			if (!allowed_.empty()) {
+				next() << "one of {";
+				for (size_t i = 0; i < allowed_.size(); ++i) {
+					os << (i == 0 ? "" : ", ");
+					write_value(os, allowed_[i]);
+				}
+				os << "}";
+			}
+			if (min_length_ != 0 || max_length_ != std::numeric_limits<size_t>::max()) {
+				next() << "length [" << min_length_ << ", ";
+				if (max_length_ != std::numeric_limits<size_t>::max()) {
+					os << max_length_ << "]";
+				} else {
+					os << ")";
+				}
+			}
+			if (pattern_) {
+				next() << "pattern \"" << pattern_source_ << "\"";
+			}
+			switch (order_) {
+			case list_order::ascending: next() << "ascending"; break;
+			case list_order::strictly_ascending: next() << "strictly ascending"; break;
+			case list_order::descending: next() << "descending"; break;
+			case list_order::strictly_descending: next() << "strictly descending"; break;
+			case list_order::any: break;
+			}
+			if (unique_) {
+				next() << "unique";
+			}
+			return os;
+		}
+	};
+}
+
+#endif // INICPP_VALUE_CONSTRAINTS_H
@@ -0,0 +1,97 @@
+#ifndef INICPP_VALUE_VIEW_H
+#define INICPP_VALUE_VIEW_H
+
+#include <cstddef>
+
+
+namespace inicpp
+{
+	/**
+	 * Read-only view over contiguous list of values, which are owned by
+	 * somebody else. Used for reading values of option without copying
+	 * them. View is valid only until the viewed option is modified.
+	 */
+	template <typename ValueType> class value_view
+	{
+	private:
+		/** First viewed value */
+		const ValueType *data_;
+		/** Number of viewed values */
+		size_t size_;
+
+	public:
+		/** Type of iterator */
+		using iterator = const ValueType *;
+		/** Type of constant iterator */
+		using const_iterator = const ValueType *;
+
+		/**
+		 * Construct empty view.
+		 */
+		value_view() : data_(nullptr), size_(0)
+		{
+		}
+		/**
+		 * Construct view of given values.
+		 * @param data pointer to the first value
+		 * @param size number of values
+		 */
+		value_view(const ValueType *data, size_t size) : data_(data), size_(size)
+		{
+		}
+
+		/**
+		 * Number of viewed values.
+		 * @return unsigned integer
+		 */
+		size_t size() const
+		{
+			return size_;
+		}
+		/**
+		 * Determines if there are no values.
+		 * @return true if view is empty
+		 */
+		bool empty() const
+		{
+			return size_ == 0;
+		}
+		/**
+		 * Pointer to the first value.
+		 * @return pointer to contiguous values
+		 */
+		const ValueType *data() const
+		{
+			return data_;
+		}
+
+		const_iterator begin() const
+		{
+			return data_;
+		}
+		const_iterator end() const
+		{
+			return data_ + size_;
+		}
+
+		/**
+		 * Access value on given position without range check.
+		 * @param position index of value
+		 * @return constant reference to value
+		 */
+		const ValueType &operator[](size_t position) const
+		{
+			return data_[position];
+		}
+		/**
+		 * Access the first value, view must not be empty.
+		 * @return constant reference to value
+		 */
+		const ValueType &front() const
+		{
+			return data_[0];
+		}
+	};
+}
+
+#endif // INICPP_VALUE_VIEW_H
@@ -0,0 +1,32 @@
+#include "arena.h"
+
+namespace inicpp
+{
+	arena::region::region(const arena *owner, size_t block_size)
+		: std::pmr::monotonic_buffer_resource(block_size), owner_(owner)
+	{
+	}
+
+	bool arena::region::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+	{
+		// regions never free single allocations, so memory of one can be "freed" by another
+		const region *other_region = dynamic_cast<const region *>(&other);
+		return other_region != nullptr && other_region->owner_ == owner_;
+	}
+
+	arena::arena(size_t block_size) : block_size_(block_size)
+	{
+		regions_.emplace_back(this, block_size_);
+	}
+
+	std::pmr::memory_resource *arena::get_resource()
+	{
+		return &regions_.front();
+	}
+
+	std::pmr::memory_resource *arena::add_resource()
+	{
+		regions_.emplace_back(this, block_size_);
+		return &regions_.back();
+	}
+}
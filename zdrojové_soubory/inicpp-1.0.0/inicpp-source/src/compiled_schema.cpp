@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <numeric>
+
+#include "compiled_schema.h"
+#include "config.h"
+#include "name_index.h"
+#include "schema.h"
+
+namespace inicpp
+{
+	compiled_schema::name_table::name_table(const std::vector<uint64_t> &hashes)
+	{
+		// buckets of one or two names and table filled at most to one half keep seeds small
+		size_t bucket_count = 1;
+		while (bucket_count * 2 < hashes.size()) {
+			bucket_count *= 2;
+		}
+		size_t slot_count = 1;
+		while (slot_count < hashes.size() * 2) {
+			slot_count *= 2;
+		}
+		seeds_.assign(bucket_count, 0);
+		slots_.assign(slot_count, slot{0, empty_slot});
+
+		std::vector<std::vector<size_t>> buckets(bucket_count);
+		for (size_t i = 0; i < hashes.size(); ++i) {
+			buckets[hashes[i] & (bucket_count - 1)].push_back(i);
+		}
+
+		// bigger buckets are placed first, while the table is still empty
+		std::vector<size_t> order(bucket_count);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(),
+			[&buckets](size_t first, size_t second) { return buckets[first].size() > buckets[second].size(); });
+
+		std::vector<size_t> taken;
+		for (size_t bucket : order) {
+			const std::vector<size_t> &members = buckets[bucket];
+			bool placed = members.empty();
+			for (uint32_t seed = 0; !placed && seed < max_seed; ++seed) {
+				placed = true;
+				taken.clear();
+				for (size_t position : members) {
+					size_t index = slot_of(hashes[position], seed);
+					if (slots_[index].position != empty_slot || std::find(taken.begin(), taken.end(), index) != taken.end()) {
+						placed = false;
+						break;
+					}
+					taken.push_back(index);
+				}
+				if (placed) {
+					seeds_[bucket] = seed;
+					for (size_t i = 0; i < members.size(); ++i) {
+						slots_[taken[i]] = slot{hashes[members[i]], members[i]};
+					}
+				}
+			}
+
+			// names with equal hashes cannot get different slots under any seed
+			if (!placed) {
+				for (size_t position : members) {
+					overflow_.push_back(slot{hashes[position], position});
+				}
+			}
+		}
+	}
+
+	size_t compiled_schema::name_table::slot_of(uint64_t name_hash, uint32_t seed) const
+	{
+		// splitmix64 finalizer, seed selects one of independent slot functions
+		uint64_t x = name_hash + (static_cast<uint64_t>(seed) + 1) * 0x9e3779b97f4a7c15ULL;
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+		x ^= x >> 31;
+		return static_cast<size_t>(x & (slots_.size() - 1));
+	}
+
+	compiled_schema::compiled_schema(const schema &schm)
+	{
+		std::vector<uint64_t> section_hashes;
+		sections_.reserve(schm.size());
+		section_hashes.reserve(schm.size());
+		for (size_t i = 0; i < schm.size(); ++i) {
+			const section_schema &sect_schema = schm[i];
+			section_plan plan;
+			plan.name = sect_schema.get_name();
+			plan.mandatory = sect_schema.is_mandatory();
+
+			std::vector<uint64_t> option_hashes;
+			plan.options.reserve(sect_schema.size());
+			option_hashes.reserve(sect_schema.size());
+			for (size_t j = 0; j < sect_schema.size(); ++j) {
+				const option_schema &opt_schema = sect_schema[j];
+				plan.options.push_back(option_plan{opt_schema.get_name(), opt_schema.is_mandatory(),
+					opt_schema.get_default_value(), opt_schema.bind_validator()});
+				option_hashes.push_back(name_index::hash(opt_schema.get_name()));
+			}
+			plan.options_table = name_table(option_hashes);
+
+			sections_.push_back(std::move(plan));
+			section_hashes.push_back(name_index::hash(sect_schema.get_name()));
+		}
+		sections_table_ = name_table(section_hashes);
+	}
+
+	size_t compiled_schema::find_section(std::string_view section_name) const
+	{
+		return sections_table_.find(name_index::hash(section_name), section_name,
+			[this](size_t position) -> const std::string & { return sections_[position].name; });
+	}
+
+	size_t compiled_schema::size() const
+	{
+		return sections_.size();
+	}
+
+	bool compiled_schema::contains(std::string_view section_name) const
+	{
+		return find_section(section_name) != name_table::npos;
+	}
+
+	void compiled_schema::validate_section(
+		section &sect, const section_plan &plan, schema_mode mode, std::vector<bool> &found) const
+	{
+		// present options are validated in the order of the section
+		found.assign(plan.options.size(), false);
+		size_t present = sect.size();
+		for (size_t i = 0; i < present; ++i) {
+			option &opt = sect[i];
+			size_t position = plan.options_table.find(name_index::hash(opt.get_name()), opt.get_name(),
+				[&plan](size_t position) -> const std::string & { return plan.options[position].name; });
+			if (position == name_table::npos) {
+				// we have strict mode and option which is not in section_schema
+				if (mode == schema_mode::strict) {
+					throw validation_exception("Option '" + opt.get_name() + "' not specified in schema");
+				}
+				continue;
+			}
+			found[position] = true;
+			plan.options[position].validate(opt);
+		}
+
+		// options which are in schema but not in section
+		for (size_t i = 0; i < plan.options.size(); ++i) {
+			if (found[i]) {
+				continue;
+			}
+			const option_plan &opt_plan = plan.options[i];
+			if (opt_plan.mandatory) {
+				throw validation_exception(
+					"Mandatory option '" + opt_plan.name + "' is missing in section '" + sect.get_name() + "'");
+			}
+			// add option with default value and validate it, so its values get type of the schema
+			sect.add_option(opt_plan.name, opt_plan.default_value);
+			opt_plan.validate(sect[sect.size() - 1]);
+		}
+	}
+
+	void compiled_schema::validate_config(config &cfg, schema_mode mode) const
+	{
+		// one pass through sections of the config
+		std::vector<bool> found_sections(sections_.size(), false);
+		std::vector<bool> found_options;
+		for (auto &sect : cfg) {
+			size_t position = find_section(sect.get_name());
+			if (position == name_table::npos) {
+				// we have strict mode and section which is not in schema
+				if (mode == schema_mode::strict) {
+					throw validation_exception("Section '" + sect.get_name() + "' not specified in schema");
+				}
+				continue;
+			}
+			found_sections[position] = true;
+			validate_section(sect, sections_[position], mode, found_options);
+		}
+
+		// sections which are in schema but not in config
+		for (size_t i = 0; i < sections_.size(); ++i) {
+			if (found_sections[i]) {
+				continue;
+			}
+			const section_plan &plan = sections_[i];
+			if (plan.mandatory) {
+				throw validation_exception("Mandatory section '" + plan.name + "' is missing in config");
+			}
+			// section is not mandatory => add section to config and all its options with default values
+			cfg.add_section(plan.name);
+			section &added = cfg[cfg.size() - 1];
+			for (auto &opt_plan : plan.options) {
+				added.add_option(opt_plan.name, opt_plan.default_value);
+			}
+		}
+	}
+}
@@ -1,4 +1,5 @@
 #include "config.h"
+#include <new>
 
 namespace inicpp
 {
@@ -6,52 +7,107 @@ namespace inicpp
 	{
 	}
 
-	config::config(const config &source)
+	config::config(const allocator_type &alloc) : sections_(alloc), index_(alloc)
 	{
-		// we have to do deep copies of sections
-		sections_.reserve(source.sections_.size());
-		for (auto &sect : source.sections_) {
-			sections_.push_back(std::make_shared<section>(*sect));
-		}
+	}
 
-		// we already have constructed sections... now push them into map
-		for (auto &sect : sections_) {
-			sections_map_.insert(sections_map_pair(sect->get_name(), sect));
-		}
+	config::config(std::shared_ptr<arena> memory)
+		: arena_(std::move(memory)), sections_(arena_->get_resource()), index_(arena_->get_resource())
+	{
+	}
+
+	config::config(const config &source) : config(source, allocator_type())
+	{
+	}
+
+	config::config(const config &source, const allocator_type &alloc)
+		: sections_(source.sections_, alloc), index_(source.index_, alloc)
+	{
 	}
 
 	config &config::operator=(const config &source)
 	{
 		if (this != &source) {
-			// make copy of input source config and swap it with this
-			config new_src(source);
-			std::swap(*this, new_src);
+			sections_ = source.sections_;
+			index_ = source.index_;
 		}
 
 		return *this;
 	}
 
-	config::config(config &&source)
+	config::config(config &&source) noexcept
+		: arena_(std::move(source.arena_)), sections_(std::move(source.sections_)), index_(std::move(source.index_))
 	{
-		operator=(std::move(source));
+		if (arena_ != nullptr) {
+			source.detach_arena();
+		}
 	}
 
 	config &config::operator=(config &&source)
 	{
 		if (this != &source) {
 			sections_ = std::move(source.sections_);
-			sections_map_ = std::move(source.sections_map_);
+			index_ = std::move(source.index_);
+			if (source.arena_ != nullptr) {
+				source.detach_arena();
+			}
 		}
 		return *this;
 	}
 
+	void config::detach_arena() noexcept
+	{
+		// allocator of containers cannot be replaced, so they are constructed again
+		sections_.~sections_vector();
+		new (&sections_) sections_vector(allocator_type());
+		index_.~name_index();
+		new (&index_) name_index(allocator_type());
+		arena_.reset();
+	}
+
+	config::allocator_type config::get_allocator() const
+	{
+		return sections_.get_allocator();
+	}
+
+	size_t config::find_section(std::string_view section_name, uint64_t name_hash) const
+	{
+		return index_.find(section_name, name_hash, [this](size_t position) -> const std::string & {
+			return sections_[position].get_name();
+		});
+	}
+
+	size_t config::section_position(std::string_view section_name) const
+	{
+		size_t position = find_section(section_name, name_index::hash(section_name));
+		if (position == name_index::npos) {
+			throw not_found_exception(std::string(section_name));
+		}
+		return position;
+	}
+
+	void config::push_section(section &&sect, uint64_t name_hash)
+	{
+		sections_.push_back(std::move(sect));
+		index_.insert(
+			name_hash, [this](size_t position) -> const std::string & { return sections_[position].get_name(); });
+	}
+
 	void config::add_section(const section &sect)
 	{
-		auto add_it = sections_map_.find(sect.get_name());
-		if (add_it == sections_map_.end()) {
-			std::shared_ptr<section> add = std::make_shared<section>(sect);
-			sections_.push_back(add);
-			sections_map_.insert(sections_map_pair(add->get_name(), add));
+		uint64_t name_hash = name_index::hash(sect.get_name());
+		if (find_section(sect.get_name(), name_hash) == name_index::npos) {
+			push_section(section(sect, sections_.get_allocator()), name_hash);
+		} else {
+			throw ambiguity_exception(sect.get_name());
+		}
+	}
+
+	void config::add_section(section &&sect)
+	{
+		uint64_t name_hash = name_index::hash(sect.get_name());
+		if (find_section(sect.get_name(), name_hash) == name_index::npos) {
+			push_section(std::move(sect), name_hash);
 		} else {
 			throw ambiguity_exception(sect.get_name());
 		}
@@ -59,11 +115,9 @@ namespace inicpp
 
 	void config::add_section(const std::string &section_name)
 	{
-		auto add_it = sections_map_.find(section_name);
-		if (add_it == sections_map_.end()) {
-			std::shared_ptr<section> add = std::make_shared<section>(section_name);
-			sections_.push_back(add);
-			sections_map_.insert(sections_map_pair(add->get_name(), add));
+		uint64_t name_hash = name_index::hash(section_name);
+		if (find_section(section_name, name_hash) == name_index::npos) {
+			push_section(section(section_name, sections_.get_allocator()), name_hash);
 		} else {
 			throw ambiguity_exception(section_name);
 		}
@@ -71,39 +125,21 @@ namespace inicpp
 
 	void config::remove_section(const std::string &section_name)
 	{
-		auto del_it = sections_map_.find(section_name);
-		if (del_it != sections_map_.end()) {
-			// remove from map
-			sections_map_.erase(del_it);
-			// remove from vector
-			sections_.erase(
-				std::remove_if(sections_.begin(),
-					sections_.end(),
-					[&](std::shared_ptr<section> sect) { return (sect->get_name() == section_name ? true : false); }),
-				sections_.end());
-		} else {
-			throw not_found_exception(section_name);
-		}
+		size_t position = section_position(section_name);
+		// remove from vector and index positions of shifted sections again
+		sections_.erase(sections_.begin() + position);
+		index_.rebuild(
+			sections_.size(), [this](size_t position) -> const std::string & { return sections_[position].get_name(); });
 	}
 
 	void config::add_option(const std::string &section_name, const option &opt)
 	{
-		auto sect_it = sections_map_.find(section_name);
-		if (sect_it != sections_map_.end()) {
-			sect_it->second->add_option(opt);
-		} else {
-			throw not_found_exception(section_name);
-		}
+		sections_[section_position(section_name)].add_option(opt);
 	}
 
 	void config::remove_option(const std::string &section_name, const std::string &option_name)
 	{
-		auto sect_it = sections_map_.find(section_name);
-		if (sect_it != sections_map_.end()) {
-			sect_it->second->remove_option(option_name);
-		} else {
-			throw not_found_exception(section_name);
-		}
+		sections_[section_position(section_name)].remove_option(option_name);
 	}
 
 	size_t config::size() const
@@ -117,7 +153,7 @@ namespace inicpp
 			throw not_found_exception(index);
 		}
 
-		return *sections_[index];
+		return sections_[index];
 	}
 
 	const section &config::operator[](size_t index) const
@@ -126,39 +162,41 @@ namespace inicpp
 			throw not_found_exception(index);
 		}
 
-		return *sections_[index];
+		return sections_[index];
 	}
 
-	section &config::operator[](const std::string &section_name)
+	section &config::operator[](std::string_view section_name)
 	{
-		std::shared_ptr<section> result;
-		try {
-			result = sections_map_.at(section_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(section_name);
-		}
-		return *result;
+		return sections_[section_position(section_name)];
 	}
 
-	const section &config::operator[](const std::string &section_name) const
+	const section &config::operator[](std::string_view section_name) const
 	{
-		std::shared_ptr<section> result;
-		try {
-			result = sections_map_.at(section_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(section_name);
-		}
-		return *result;
+		return sections_[section_position(section_name)];
 	}
 
-	bool config::contains(const std::string &section_name) const
+	bool config::contains(std::string_view section_name) const
 	{
-		try {
-			sections_map_.at(section_name);
-			return true;
-		} catch (std::out_of_range) {
-			return false;
+		return find_section(section_name, name_index::hash(section_name)) != name_index::npos;
+	}
+
+	option &config::get_option(const option_key &key)
+	{
+		return const_cast<option &>(static_cast<const config *>(this)->get_option(key));
+	}
+
+	const option &config::get_option(const option_key &key) const
+	{
+		size_t section_position = find_section(key.section_name(), key.section_hash());
+		if (section_position == name_index::npos) {
+			throw not_found_exception(std::string(key.section_name()));
+		}
+		const section &sect = sections_[section_position];
+		size_t option_position = sect.find_option(key.option_name(), key.option_hash());
+		if (option_position == name_index::npos) {
+			throw not_found_exception(std::string(key.option_name()));
 		}
+		return sect.options_[option_position];
 	}
 
 	void config::validate(const schema &schm, schema_mode mode)
@@ -166,14 +204,19 @@ namespace inicpp
 		schm.validate_config(*this, mode);
 	}
 
+	void config::validate(const schema &schm, schema_mode mode, executor &exec)
+	{
+		schm.validate_config(*this, mode, exec);
+	}
+
+	void config::validate(const compiled_schema &plan, schema_mode mode)
+	{
+		plan.validate_config(*this, mode);
+	}
+
 	bool config::operator==(const config &other) const
 	{
-		return std::equal(sections_.begin(),
-			sections_.end(),
-			other.sections_.begin(),
-			[](const std::shared_ptr<section> &first, const std::shared_ptr<section> &second) {
-				return *first == *second;
-			});
+		return std::equal(sections_.begin(), sections_.end(), other.sections_.begin());
 	}
 
 	bool config::operator!=(const config &other) const
@@ -214,7 +257,7 @@ namespace inicpp
 	std::ostream &operator<<(std::ostream &os, const config &conf)
 	{
 		for (auto &sect : conf.sections_) {
-			os << *sect;
+			os << sect;
 		}
 
 		return os;
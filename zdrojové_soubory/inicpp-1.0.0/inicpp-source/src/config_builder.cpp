@@ -0,0 +1,68 @@
+#include "config_builder.h"
+
+namespace inicpp
+{
+	config_builder::config_builder()
+	{
+	}
+
+	config_builder::config_builder(const allocator_type &alloc) : cfg_(alloc)
+	{
+	}
+
+	config_builder::config_builder(config &&cfg) : cfg_(std::move(cfg))
+	{
+	}
+
+	config_builder::allocator_type config_builder::get_allocator() const
+	{
+		return cfg_.get_allocator();
+	}
+
+	section &config_builder::add_section(const std::string &section_name)
+	{
+		cfg_.add_section(section_name);
+		return cfg_.sections_.back();
+	}
+
+	section &config_builder::add_section(section &&sect)
+	{
+		cfg_.add_section(std::move(sect));
+		return cfg_.sections_.back();
+	}
+
+	section &config_builder::last_section()
+	{
+		if (cfg_.sections_.empty()) {
+			throw not_found_exception(0);
+		}
+		return cfg_.sections_.back();
+	}
+
+	option &config_builder::add_option(option &&opt)
+	{
+		section &sect = last_section();
+		sect.add_option(std::move(opt));
+		return sect.options_.back();
+	}
+
+	option &config_builder::add_option(const std::string &option_name, std::vector<std::string> &&values)
+	{
+		section &sect = last_section();
+		return add_option(option(option_name, std::move(values), sect.get_allocator()));
+	}
+
+	size_t config_builder::size() const
+	{
+		return cfg_.size();
+	}
+
+	config config_builder::build()
+	{
+		// moved from config keeps its allocator unless it owned an arena, only its containers are emptied
+		config built(std::move(cfg_));
+		cfg_.sections_.clear();
+		cfg_.index_.clear();
+		return built;
+	}
+}
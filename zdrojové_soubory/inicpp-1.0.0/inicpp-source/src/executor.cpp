@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "executor.h"
+
+namespace inicpp
+{
+	executor::~executor()
+	{
+	}
+
+	thread_executor::thread_executor(size_t threads) : threads_(threads)
+	{
+		if (threads_ == 0) {
+			threads_ = std::max(std::thread::hardware_concurrency(), 1u);
+		}
+	}
+
+	size_t thread_executor::get_threads() const
+	{
+		return threads_;
+	}
+
+	void thread_executor::run(size_t count, const std::function<void(size_t)> &task)
+	{
+		size_t worker_count = std::min(threads_, count);
+		std::atomic<size_t> next(0);
+		auto work = [&]() {
+			for (size_t i = next++; i < count; i = next++) {
+				task(i);
+			}
+		};
+
+		std::vector<std::thread> workers;
+		workers.reserve(worker_count);
+		try {
+			for (size_t i = 1; i < worker_count; ++i) {
+				workers.emplace_back(work);
+			}
+		} catch (...) {
+			// tasks which are already running have to finish before their data is released
+			next = count;
+			for (auto &worker : workers) {
+				worker.join();
+			}
+			throw;
+		}
+		work();
+		for (auto &worker : workers) {
+			worker.join();
+		}
+	}
+}
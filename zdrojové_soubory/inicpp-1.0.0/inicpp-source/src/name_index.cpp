@@ -0,0 +1,173 @@
+#include "name_index.h"
+#include <chrono>
+#include <cstring>
+#include <random>
+
+namespace inicpp
+{
+	namespace
+	{
+		/** Key of SipHash function */
+		struct hash_key {
+			uint64_t k0;
+			uint64_t k1;
+		};
+
+		/**
+		 * Random key shared by all indexes in the process. Random device may
+		 * be unavailable or deterministic on some platforms, so it is mixed
+		 * with current time and address of the key itself.
+		 */
+		const hash_key &process_key()
+		{
+			static const hash_key key = []() {
+				uint64_t entropy = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+				entropy ^= reinterpret_cast<uintptr_t>(&entropy);
+				uint64_t k0 = entropy;
+				uint64_t k1 = entropy * 0x9e3779b97f4a7c15ULL;
+				try {
+					std::random_device device;
+					k0 ^= (static_cast<uint64_t>(device()) << 32) | device();
+					k1 ^= (static_cast<uint64_t>(device()) << 32) | device();
+				} catch (std::exception &) {
+					// time and address are used alone
+				}
+				return hash_key{k0, k1};
+			}();
+			return key;
+		}
+
+		/** Source of layout identifiers, zero is never assigned */
+		std::atomic<uint64_t> last_layout(0);
+
+		inline uint64_t rotl(uint64_t x, int bits)
+		{
+			return (x << bits) | (x >> (64 - bits));
+		}
+
+		/** One SipHash round over internal state */
+		inline void sip_round(uint64_t &v0, uint64_t &v1, uint64_t &v2, uint64_t &v3)
+		{
+			v0 += v1;
+			v1 = rotl(v1, 13);
+			v1 ^= v0;
+			v0 = rotl(v0, 32);
+			v2 += v3;
+			v3 = rotl(v3, 16);
+			v3 ^= v2;
+			v0 += v3;
+			v3 = rotl(v3, 21);
+			v3 ^= v0;
+			v2 += v1;
+			v1 = rotl(v1, 17);
+			v1 ^= v2;
+			v2 = rotl(v2, 32);
+		}
+	}
+
+	name_index::name_index() : size_(0), layout_(0)
+	{
+	}
+
+	name_index::name_index(const allocator_type &alloc) : slots_(alloc), size_(0), layout_(0)
+	{
+	}
+
+	name_index::name_index(const name_index &source)
+		: slots_(source.slots_), size_(source.size_), layout_(source.layout())
+	{
+	}
+
+	name_index::name_index(const name_index &source, const allocator_type &alloc)
+		: slots_(source.slots_, alloc), size_(source.size_), layout_(source.layout())
+	{
+	}
+
+	name_index &name_index::operator=(const name_index &source)
+	{
+		if (this != &source) {
+			slots_ = source.slots_;
+			size_ = source.size_;
+			layout_.store(source.layout(), std::memory_order_relaxed);
+		}
+		return *this;
+	}
+
+	name_index::name_index(name_index &&source) noexcept
+		: slots_(std::move(source.slots_)), size_(source.size_),
+		  layout_(source.layout_.load(std::memory_order_relaxed))
+	{
+		source.clear();
+	}
+
+	name_index::name_index(name_index &&source, const allocator_type &alloc)
+		: slots_(std::move(source.slots_), alloc), size_(source.size_),
+		  layout_(source.layout_.load(std::memory_order_relaxed))
+	{
+		source.clear();
+	}
+
+	name_index &name_index::operator=(name_index &&source)
+	{
+		if (this != &source) {
+			slots_ = std::move(source.slots_);
+			size_ = source.size_;
+			layout_.store(source.layout_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			source.clear();
+		}
+		return *this;
+	}
+
+	uint64_t name_index::assign_layout() const
+	{
+		uint64_t id = last_layout.fetch_add(1, std::memory_order_relaxed) + 1;
+		uint64_t expected = 0;
+		if (!layout_.compare_exchange_strong(expected, id, std::memory_order_relaxed)) {
+			// other thread assigned identifier meanwhile
+			return expected;
+		}
+		return id;
+	}
+
+	uint64_t name_index::hash(std::string_view name)
+	{
+		// SipHash-1-3, one compression round per block and three finalization rounds
+		const hash_key &key = process_key();
+		uint64_t v0 = 0x736f6d6570736575ULL ^ key.k0;
+		uint64_t v1 = 0x646f72616e646f6dULL ^ key.k1;
+		uint64_t v2 = 0x6c7967656e657261ULL ^ key.k0;
+		uint64_t v3 = 0x7465646279746573ULL ^ key.k1;
+
+		const char *data = name.data();
+		size_t blocks = name.size() / 8;
+		for (size_t i = 0; i < blocks; ++i) {
+			uint64_t block;
+			std::memcpy(&block, data + i * 8, 8);
+			v3 ^= block;
+			sip_round(v0, v1, v2, v3);
+			v0 ^= block;
+		}
+
+		uint64_t last = static_cast<uint64_t>(name.size()) << 56;
+		const unsigned char *tail = reinterpret_cast<const unsigned char *>(data + blocks * 8);
+		for (size_t i = 0; i < name.size() % 8; ++i) {
+			last |= static_cast<uint64_t>(tail[i]) << (8 * i);
+		}
+		v3 ^= last;
+		sip_round(v0, v1, v2, v3);
+		v0 ^= last;
+
+		v2 ^= 0xff;
+		sip_round(v0, v1, v2, v3);
+		sip_round(v0, v1, v2, v3);
+		sip_round(v0, v1, v2, v3);
+		return v0 ^ v1 ^ v2 ^ v3;
+	}
+
+	void name_index::clear()
+	{
+		slots_.clear();
+		size_ = 0;
+		layout_.store(0, std::memory_order_relaxed);
+	}
+}
@@ -3,68 +3,95 @@
 
 namespace inicpp
 {
-	option::option(const option &source)
+	namespace
+	{
+		/** Copies list of values of any type using given allocator */
+		option_values copy_values(const option_values &values, const option::allocator_type &alloc)
+		{
+			return std::visit(
+				[&alloc](const auto &list) {
+					using list_type = std::decay_t<decltype(list)>;
+					return option_values(std::in_place_type<list_type>, list, alloc);
+				},
+				values);
+		}
+
+		/** Moves list of values of any type using given allocator, values are copied if allocators differ */
+		option_values move_values(option_values &&values, const option::allocator_type &alloc)
+		{
+			return std::visit(
+				[&alloc](auto &list) {
+					using list_type = std::decay_t<decltype(list)>;
+					return option_values(std::in_place_type<list_type>, std::move(list), alloc);
+				},
+				values);
+		}
+	}
+
+	option::option(const option &source) : option(source, allocator_type())
+	{
+	}
+
+	option::option(const option &source, const allocator_type &alloc)
+		: name_(source.name_), values_(copy_values(source.values_, alloc))
 	{
-		this->operator=(source);
 	}
 
 	option &option::operator=(const option &source)
 	{
 		if (&source != this) {
-			values_.clear();
+			cache_.clear();
 			name_ = source.name_;
-			type_ = source.type_;
-			for (const auto &value : source.values_) {
-				switch (type_) {
-				case option_type::boolean_e: copy_option<boolean_ini_t>(value); break;
-				case option_type::enum_e: copy_option<enum_ini_t>(value); break;
-				case option_type::float_e: copy_option<float_ini_t>(value); break;
-				case option_type::signed_e: copy_option<signed_ini_t>(value); break;
-				case option_type::string_e: copy_option<string_ini_t>(value); break;
-				case option_type::unsigned_e: copy_option<unsigned_ini_t>(value); break;
-				case option_type::date_e: copy_option<date_ini_t>(value); break;
-				case option_type::locale_e: copy_option<locale_ini_t>(value); break;
-				case option_type::invalid_e:
-					// never reached
-					throw invalid_type_exception("Invalid option type");
-					break;
-				}
-			}
-			option_schema_ = source.option_schema_;
+			values_ = copy_values(source.values_, get_allocator());
 		}
 		return *this;
 	}
 
-	option::option(option &&source)
+	option::option(option &&source) noexcept
+		: name_(std::move(source.name_)), values_(std::move(source.values_))
+	{
+		source.cache_.clear();
+	}
+
+	option::option(option &&source, const allocator_type &alloc)
+		: name_(std::move(source.name_)), values_(move_values(std::move(source.values_), alloc))
 	{
-		name_ = source.name_;
-		type_ = source.type_;
-		values_ = std::move(source.values_);
-		option_schema_ = std::move(source.option_schema_);
+		source.cache_.clear();
 	}
 
 	option &option::operator=(option &&source)
 	{
 		if (&source != this) {
-			name_ = source.name_;
-			type_ = source.type_;
-			values_ = std::move(source.values_);
-			option_schema_ = std::move(source.option_schema_);
+			cache_.clear();
+			source.cache_.clear();
+			name_ = std::move(source.name_);
+			values_ = move_values(std::move(source.values_), get_allocator());
 		}
 		return *this;
 	}
 
-	option::option(const std::string &name, const std::string &value) : name_(name), type_(option_type::string_e)
+	option::option(const std::string &name, const std::string &value, const allocator_type &alloc)
+		: name_(name), values_(std::in_place_type<value_list<string_ini_t>>, alloc)
 	{
-		add_to_list<string_ini_t>(value);
+		typed_values<string_ini_t>().push_back(value);
 	}
 
-	option::option(const std::string &name, const std::vector<std::string> &values)
-		: name_(name), type_(option_type::string_e)
+	option::option(const std::string &name, const std::vector<std::string> &values, const allocator_type &alloc)
+		: name_(name), values_(std::in_place_type<value_list<string_ini_t>>, values.begin(), values.end(), alloc)
+	{
+	}
+
+	option::option(const std::string &name, std::vector<std::string> &&values, const allocator_type &alloc)
+		: name_(name), values_(std::in_place_type<value_list<string_ini_t>>,
+						   std::make_move_iterator(values.begin()),
+						   std::make_move_iterator(values.end()),
+						   alloc)
 	{
-		for (const auto &input_value : values) {
-			add_to_list<string_ini_t>(input_value);
-		}
+	}
+
+	option::allocator_type option::get_allocator() const
+	{
+		return std::visit([](const auto &list) { return allocator_type(list.get_allocator()); }, values_);
 	}
 
 	const std::string &option::get_name() const
@@ -74,15 +101,21 @@ namespace inicpp
 
 	option_type option::get_type() const
 	{
-		return type_;
+		return static_cast<option_type>(values_.index());
+	}
+
+	std::string_view option::get_string_view() const
+	{
+		return get_ref<string_ini_t>();
 	}
 
 	void option::remove_from_list_pos(size_t position)
 	{
-		if (position >= values_.size()) {
+		if (position >= values_count()) {
 			throw not_found_exception(position);
 		}
-		values_.erase(values_.begin() + position);
+		cache_.clear();
+		std::visit([position](auto &list) { list.erase(list.begin() + position); }, values_);
 	}
 
 	void option::validate(const option_schema &opt_schema)
@@ -92,60 +125,8 @@ namespace inicpp
 
 	bool option::operator==(const option &other) const
 	{
-		if (name_ != other.name_ || type_ != other.type_) {
-			return false;
-		}
-
-		if (values_.size() != other.values_.size()) {
-			return false;
-		} else {
-			for (size_t i = 0; i < values_.size(); ++i) {
-				switch (type_) {
-				case option_type::boolean_e:
-					if (!compare_option<boolean_ini_t>(values_[i], other.values_[i])) {
-						return false;
-					}
-					break;
-				case option_type::enum_e:
-					if (!compare_option<enum_ini_t>(values_[i], other.values_[i])) {
-						return false;
-					}
-					break;
-				case option_type::float_e:
-					if (!compare_option<float_ini_t>(values_[i], other.values_[i])) {
-						return false;
-					}
-					break;
-				case option_type::signed_e:
-					if (!compare_option<signed_ini_t>(values_[i], other.values_[i])) {
-						return false;
-					}
-					break;
-				case option_type::string_e:
-					if (!compare_option<string_ini_t>(values_[i], other.values_[i])) {
-						return false;
-					}
-					break;
-				case option_type::unsigned_e:
-					if (!compare_option<unsigned_ini_t>(values_[i], other.values_[i])) {
-						return false;
-					}
-					break;
-				case option_type::date_e:
-					if (!compare_option<date_ini_t>(values_[i], other.values_[i])) {
-						return false;
-					}
-					break;
-				case option_type::locale_e:
-					if (!compare_option<locale_ini_t>(values_[i], other.values_[i])) {
-						return false;
-					}
-					break;
-				default: throw invalid_type_exception("Invalid option type"); break;
-				}
-			}
-		}
-		return true;
+		// lists of different types are never equal
+		return name_ == other.name_ && values_ == other.values_;
 	}
 
 	bool option::operator!=(const option &other) const
@@ -155,176 +136,127 @@ namespace inicpp
 
 	bool option::is_list() const
 	{
-		return values_.size() > 1;
+		return values_count() > 1;
 	}
 
 	option &option::operator=(boolean_ini_t arg)
 	{
-		values_.clear();
-		type_ = option_type::boolean_e;
-		add_to_list<boolean_ini_t>(arg);
-		return *this;
+		return assign_single<boolean_ini_t>(std::move(arg));
 	}
 
 	option &option::operator=(signed_ini_t arg)
 	{
-		values_.clear();
-		type_ = option_type::signed_e;
-		add_to_list<signed_ini_t>(arg);
-		return *this;
+		return assign_single<signed_ini_t>(std::move(arg));
 	}
 
 	option &option::operator=(unsigned_ini_t arg)
 	{
-		values_.clear();
-		type_ = option_type::unsigned_e;
-		add_to_list<unsigned_ini_t>(arg);
-		return *this;
+		return assign_single<unsigned_ini_t>(std::move(arg));
 	}
 
 	option &option::operator=(float_ini_t arg)
 	{
-		values_.clear();
-		type_ = option_type::float_e;
-		add_to_list<float_ini_t>(arg);
-		return *this;
+		return assign_single<float_ini_t>(std::move(arg));
 	}
 
 	option &option::operator=(const char *arg)
 	{
-		values_.clear();
-		type_ = option_type::string_e;
-		add_to_list<string_ini_t>(arg);
-		return *this;
+		return assign_single<string_ini_t>(arg);
 	}
 
 	option &option::operator=(string_ini_t arg)
 	{
-		values_.clear();
-		type_ = option_type::string_e;
-		add_to_list<string_ini_t>(arg);
-		return *this;
+		return assign_single<string_ini_t>(std::move(arg));
 	}
 
 	option &option::operator=(enum_ini_t arg)
 	{
-		values_.clear();
-		type_ = option_type::enum_e;
-		add_to_list<enum_ini_t>(arg);
-		return *this;
+		return assign_single<enum_ini_t>(std::move(arg));
 	}
 
 	option &option::operator=(date_ini_t arg)
 	{
-		values_.clear();
-		type_ = option_type::date_e;
-		add_to_list<date_ini_t>(arg);
-		return *this;
+		return assign_single<date_ini_t>(std::move(arg));
 	}
 
 	option &option::operator=(locale_ini_t arg)
 	{
-		values_.clear();
-		type_ = option_type::locale_e;
-		add_to_list<locale_ini_t>(arg);
-		return *this;
+		return assign_single<locale_ini_t>(std::move(arg));
 	}
 
 
 	// ----- Write functions -----
 
 
-	std::string escape_option_value(const std::string &str)
-	{
-		std::string result(str);
-		if (str.length() > 0 && std::isspace(result[0])) {
-			result.insert(result.begin(), '\\');
-		}
-		if (str.length() > 1 && std::isspace(result[result.length() - 1])) {
-			result.insert(result.end() - 1, '\\');
-		}
-
-		return result;
-	}
-
-	void write_boolean_option(std::vector<boolean_ini_t> values, std::ostream &os)
+	void write_boolean_option(const value_list<boolean_ini_t> &values, std::ostream &os)
 	{
-		if (values[0]) {
-			os << "yes";
-		} else {
-			os << "no";
-		}
+		os << string_utils::format_boolean(values[0]);
 		for (auto it = values.begin() + 1; it != values.end(); ++it) {
-			os << ",";
-			if (*it) {
-				os << "yes";
-			} else {
-				os << "no";
-			}
+			os << "," << string_utils::format_boolean(*it);
 		}
 	}
-	void write_enum_option(std::vector<enum_ini_t> values, std::ostream &os)
+	void write_enum_option(const value_list<enum_ini_t> &values, std::ostream &os)
 	{
-		os << escape_option_value(static_cast<std::string>(values[0]));
+		os << string_utils::escape(static_cast<std::string>(values[0]));
 		for (auto it = values.begin() + 1; it != values.end(); ++it) {
-			os << "," << escape_option_value(static_cast<std::string>(*it));
+			os << "," << string_utils::escape(static_cast<std::string>(*it));
 		}
 	}
-	void write_float_option(std::vector<float_ini_t> values, std::ostream &os)
+	void write_float_option(const value_list<float_ini_t> &values, std::ostream &os)
 	{
 		os << values[0];
 		for (auto it = values.begin() + 1; it != values.end(); ++it) {
 			os << "," << *it;
 		}
 	}
-	void write_signed_option(std::vector<signed_ini_t> values, std::ostream &os)
+	void write_signed_option(const value_list<signed_ini_t> &values, std::ostream &os)
 	{
 		os << values[0];
 		for (auto it = values.begin() + 1; it != values.end(); ++it) {
 			os << "," << *it;
 		}
 	}
-	void write_unsigned_option(std::vector<unsigned_ini_t> values, std::ostream &os)
+	void write_unsigned_option(const value_list<unsigned_ini_t> &values, std::ostream &os)
 	{
 		os << values[0];
 		for (auto it = values.begin() + 1; it != values.end(); ++it) {
 			os << "," << *it;
 		}
 	}
-	void write_string_option(std::vector<string_ini_t> values, std::ostream &os)
+	void write_string_option(const value_list<string_ini_t> &values, std::ostream &os)
 	{
-		os << escape_option_value(values[0]);
+		os << string_utils::escape(values[0]);
 		for (auto it = values.begin() + 1; it != values.end(); ++it) {
-			os << "," << escape_option_value(*it);
+			os << "," << string_utils::escape(*it);
 		}
 	}
-	void write_date_option(std::vector<date_ini_t> values, std::ostream &os)
+	void write_date_option(const value_list<date_ini_t> &values, std::ostream &os)
 	{
 		os << std::put_time(&values[0].as_tm(), date_ini_t::DATE_FORMAT_STRING);
 		for (auto it = values.begin() + 1; it != values.end(); ++it) {
 			os << "," << std::put_time(&it->as_tm(), date_ini_t::DATE_FORMAT_STRING);
 		}
 	}
-	void write_locale_option(std::vector<locale_ini_t> values, std::ostream &os)
+	void write_locale_option(const value_list<locale_ini_t> &values, std::ostream &os)
 	{
-		os << escape_option_value(values[0]);
+		os << string_utils::escape(values[0].name());
 		for (auto it = values.begin() + 1; it != values.end(); ++it) {
-			os << "," << escape_option_value(*it);
+			os << "," << string_utils::escape(it->name());
 		}
 	}
 
 	std::ostream &operator<<(std::ostream &os, const option &opt)
 	{
 		os << opt.name_ << " = ";
-		switch (opt.type_) {
-		case option_type::boolean_e: write_boolean_option(opt.get_list<boolean_ini_t>(), os); break;
-		case option_type::enum_e: write_enum_option(opt.get_list<enum_ini_t>(), os); break;
-		case option_type::float_e: write_float_option(opt.get_list<float_ini_t>(), os); break;
-		case option_type::signed_e: write_signed_option(opt.get_list<signed_ini_t>(), os); break;
-		case option_type::string_e: write_string_option(opt.get_list<string_ini_t>(), os); break;
-		case option_type::unsigned_e: write_unsigned_option(opt.get_list<unsigned_ini_t>(), os); break;
-		case option_type::date_e: write_date_option(opt.get_list<date_ini_t>(), os); break;
-		case option_type::locale_e: write_locale_option(opt.get_list<locale_ini_t>(), os); break;
+		switch (opt.get_type()) {
+		case option_type::boolean_e: write_boolean_option(opt.typed_values<boolean_ini_t>(), os); break;
+		case option_type::enum_e: write_enum_option(opt.typed_values<enum_ini_t>(), os); break;
+		case option_type::float_e: write_float_option(opt.typed_values<float_ini_t>(), os); break;
+		case option_type::signed_e: write_signed_option(opt.typed_values<signed_ini_t>(), os); break;
+		case option_type::string_e: write_string_option(opt.typed_values<string_ini_t>(), os); break;
+		case option_type::unsigned_e: write_unsigned_option(opt.typed_values<unsigned_ini_t>(), os); break;
+		case option_type::date_e: write_date_option(opt.typed_values<date_ini_t>(), os); break;
+		case option_type::locale_e: write_locale_option(opt.typed_values<locale_ini_t>(), os); break;
 		case option_type::invalid_e:
 			// never reached
 			throw invalid_type_exception("Invalid option type");
@@ -0,0 +1,45 @@
+#include "option_handle.h"
+
+namespace inicpp
+{
+	option_handle::option_handle(const std::string &section_name, const std::string &option_name)
+		: section_name_(section_name), option_name_(option_name), config_layout_(0), section_layout_(0),
+		  section_position_(0), option_position_(0)
+	{
+	}
+
+	option_handle::option_handle(const config &cfg, const std::string &section_name, const std::string &option_name)
+		: option_handle(section_name, option_name)
+	{
+		remap(cfg);
+	}
+
+	const std::string &option_handle::get_section_name() const
+	{
+		return section_name_;
+	}
+
+	const std::string &option_handle::get_option_name() const
+	{
+		return option_name_;
+	}
+
+	const option &option_handle::remap(const config &cfg)
+	{
+		// handle stays unmapped if the option cannot be found
+		config_layout_ = 0;
+
+		size_t section_position = cfg.section_position(section_name_);
+		const section &sect = cfg.sections_[section_position];
+		size_t option_position = sect.find_option(option_name_, name_index::hash(option_name_));
+		if (option_position == name_index::npos) {
+			throw not_found_exception(option_name_);
+		}
+
+		section_position_ = section_position;
+		option_position_ = option_position;
+		section_layout_ = sect.index_.layout();
+		config_layout_ = cfg.index_.layout();
+		return sect.options_[option_position];
+	}
+}
@@ -3,6 +3,181 @@
 
 namespace inicpp
 {
+	namespace
+	{
+		/**
+		 * Run validator on given items.
+		 * @param items range of values of ValueType, typically view of option values
+		 * @param validator validator of schema, can be empty
+		 * @param option_name name of validated option used in error message
+		 * @throws validation_exception if validator refuses some item
+		 */
+		template <typename ValueType, typename ItemRange>
+		void validate_items(
+			const ItemRange &items, const std::function<bool(ValueType)> &validator, const std::string &option_name)
+		{
+			if (validator == nullptr) {
+				return;
+			}
+			for (const auto &item : items) {
+				if (!validator(item)) {
+					throw validation_exception("Option '" + option_name + "' - validation failed");
+				}
+			}
+		}
+
+		/**
+		 * Validate option against schema of given value type. Values of other
+		 * type are parsed into ValueType first, except for string schema which
+		 * accepts values of any type and converts them only for validation.
+		 * @param opt validated option
+		 * @param list true if schema requires list
+		 * @param validator validator of schema, can be empty
+		 * @param constraints declarative constraints of schema
+		 * @throws validation_exception if option does not fulfil the schema
+		 */
+		template <typename ValueType>
+		void validate_typed_option(option &opt, bool list, const std::function<bool(ValueType)> &validator,
+			const value_constraints<ValueType> &constraints)
+		{
+			if (!list && opt.is_list()) {
+				throw validation_exception("Option '" + opt.get_name() + "' - list given, single value expected");
+			} else if (list && !opt.is_list()) {
+				throw validation_exception("Option '" + opt.get_name() + "' - single value given, list expected");
+			}
+
+			if constexpr (std::is_same<ValueType, string_ini_t>::value) {
+				if (opt.get_type() == option_type::string_e) {
+					constraints.validate(opt.get_view<string_ini_t>(), opt.get_name());
+					validate_items(opt.get_view<string_ini_t>(), validator, opt.get_name());
+				} else if (validator != nullptr || !constraints.empty()) {
+					std::vector<std::string> converted = opt.get_list<string_ini_t>();
+					constraints.validate(value_view<std::string>(converted.data(), converted.size()), opt.get_name());
+					validate_items(converted, validator, opt.get_name());
+				}
+			} else {
+				if (opt.get_type() != get_option_enum_type<ValueType>()) {
+					// strings are parsed in place, values of other types are converted to strings first
+					std::vector<std::string> converted;
+					value_view<std::string> items;
+					if (opt.get_type() == option_type::string_e) {
+						items = opt.get_view<string_ini_t>();
+					} else {
+						converted = opt.get_list<string_ini_t>();
+						items = value_view<std::string>(converted.data(), converted.size());
+					}
+
+					std::vector<ValueType> typed_items;
+					typed_items.reserve(items.size());
+					for (const auto &item : items) {
+						typed_items.push_back(string_utils::parse_string<ValueType>(item, opt.get_name()));
+					}
+					opt.set_list<ValueType>(typed_items);
+				}
+
+				// values have type of the schema after parsing, validate them in place
+				constraints.validate(opt.get_view<ValueType>(), opt.get_name());
+				validate_items(opt.get_view<ValueType>(), validator, opt.get_name());
+			}
+		}
+
+		/**
+		 * Params of option schema, which dynamic type is given by type of the schema.
+		 * @param params properties of option schema of ValueType
+		 * @return reference to params of ValueType
+		 */
+		template <typename ValueType>
+		const option_schema_params<ValueType> &typed_params(const option_schema_params_base &params)
+		{
+			return static_cast<const option_schema_params<ValueType> &>(params);
+		}
+
+		/**
+		 * Validate option against schema params of ValueType.
+		 * @param opt validated option
+		 * @param params properties of option schema of ValueType
+		 * @throws validation_exception if option does not fulfil the schema
+		 */
+		template <typename ValueType> void validate_with_params(option &opt, const option_schema_params_base &params)
+		{
+			const option_schema_params<ValueType> &typed = typed_params<ValueType>(params);
+			validate_typed_option<ValueType>(opt, typed.type == option_item::list, typed.validator, typed.constraints);
+		}
+
+		/**
+		 * Creates standalone validation function for schema of ValueType.
+		 * @param params properties of option schema of ValueType
+		 * @return function with its own copy of the validator
+		 */
+		template <typename ValueType> option_schema::bound_validator bind_typed_validator(
+			const option_schema_params_base &params)
+		{
+			std::function<bool(ValueType)> validator = typed_params<ValueType>(params).validator;
+			value_constraints<ValueType> constraints = typed_params<ValueType>(params).constraints;
+			bool list = params.type == option_item::list;
+			return [validator, constraints, list](option &opt) {
+				validate_typed_option<ValueType>(opt, list, validator, constraints);
+			};
+		}
+
+		/**
+		 * Adds statistics of validator of params of ValueType, if it is memoized and its cache is not there yet.
+		 * @param params properties of option schema of ValueType
+		 * @param caches counters of already collected caches
+		 */
+		template <typename ValueType> void collect_typed_memo_statistics(
+			const option_schema_params_base &params, memo_caches &caches)
+		{
+			auto memoized = typed_params<ValueType>(params).validator.template target<memoized_validator<ValueType>>();
+			if (memoized != nullptr && caches.find(memoized->cache_id()) == caches.end()) {
+				caches.emplace(memoized->cache_id(), memoized->statistics());
+			}
+		}
+
+		/**
+		 * Writes constraints of params of ValueType as a comment line, if there are some.
+		 * @param params properties of option schema of ValueType
+		 * @param os output stream
+		 */
+		template <typename ValueType> void write_constraints(const option_schema_params_base &params, std::ostream &os)
+		{
+			const value_constraints<ValueType> &constraints = typed_params<ValueType>(params).constraints;
+			if (!constraints.empty()) {
+				os << ";<constraints: ";
+				constraints.write(os);
+				os << ">" << std::endl;
+			}
+		}
+
+		/**
+		 * Creates option of ValueType from escaped strings, every value is unescaped
+		 * into reused buffer and parsed from it straight into the list of the option.
+		 * @param option_name name of created option
+		 * @param values escaped values
+		 * @param alloc allocator of created option
+		 * @return option with parsed values
+		 * @throws invalid_type_exception if some value cannot be parsed
+		 */
+		template <typename ValueType>
+		option parse_typed_option(const std::string &option_name, const std::vector<std::string_view> &values,
+			const option::allocator_type &alloc)
+		{
+			value_list<ValueType> list(alloc);
+			list.reserve(values.size());
+			std::string unescaped;
+			for (auto value : values) {
+				unescaped.clear();
+				string_utils::unescape(value, unescaped);
+				if constexpr (std::is_same<ValueType, string_ini_t>::value) {
+					list.push_back(unescaped);
+				} else {
+					list.push_back(string_utils::parse_string<ValueType>(unescaped, option_name));
+				}
+			}
+			return option(option_name, std::move(list), alloc);
+		}
+	}
+
 	option_schema::option_schema(const option_schema &source)
 	{
 		this->operator=(source);
@@ -76,93 +251,80 @@ namespace inicpp
 
 	void option_schema::validate_option(option &opt) const
 	{
-		if (params_->type == option_item::single && opt.is_list()) {
-			throw validation_exception("Option '" + opt.get_name() + "' - list given, single value expected");
-		} else if (params_->type == option_item::list && !opt.is_list()) {
-			throw validation_exception("Option '" + opt.get_name() + "' - single value given, list expected");
+		// type of the schema determines dynamic type of params, so no cast has to be checked
+		switch (type_) {
+		case option_type::boolean_e: validate_with_params<boolean_ini_t>(opt, *params_); break;
+		case option_type::enum_e: validate_with_params<enum_ini_t>(opt, *params_); break;
+		case option_type::float_e: validate_with_params<float_ini_t>(opt, *params_); break;
+		case option_type::signed_e: validate_with_params<signed_ini_t>(opt, *params_); break;
+		case option_type::string_e: validate_with_params<string_ini_t>(opt, *params_); break;
+		case option_type::unsigned_e: validate_with_params<unsigned_ini_t>(opt, *params_); break;
+		case option_type::date_e: validate_with_params<date_ini_t>(opt, *params_); break;
+		case option_type::locale_e: validate_with_params<locale_ini_t>(opt, *params_); break;
+		case option_type::invalid_e:
+			// never reached
+			throw invalid_type_exception("Option '" + opt.get_name() + "' - invalid option type");
+			break;
 		}
+	}
 
-		// if option type doesn't match, parse it to proper one
-		if (opt.get_type() != type_) {
-			parse_option_items(opt);
+	option_schema::bound_validator option_schema::bind_validator() const
+	{
+		switch (type_) {
+		case option_type::boolean_e: return bind_typed_validator<boolean_ini_t>(*params_);
+		case option_type::enum_e: return bind_typed_validator<enum_ini_t>(*params_);
+		case option_type::float_e: return bind_typed_validator<float_ini_t>(*params_);
+		case option_type::signed_e: return bind_typed_validator<signed_ini_t>(*params_);
+		case option_type::string_e: return bind_typed_validator<string_ini_t>(*params_);
+		case option_type::unsigned_e: return bind_typed_validator<unsigned_ini_t>(*params_);
+		case option_type::date_e: return bind_typed_validator<date_ini_t>(*params_);
+		case option_type::locale_e: return bind_typed_validator<locale_ini_t>(*params_);
+		case option_type::invalid_e:
+			// never reached
+			break;
 		}
-
-		// validate range using provided validator
-		validate_option_items(opt);
+		throw invalid_type_exception("Invalid option type");
 	}
 
-	void option_schema::validate_option_items(option &opt) const
+	option option_schema::parse_option(const std::string &option_name, const std::vector<std::string_view> &values,
+		const std::pmr::polymorphic_allocator<char> &alloc) const
 	{
-		// load value and call validate function on it
 		switch (type_) {
-		case option_type::boolean_e:
-			validate_typed_option_items<boolean_ini_t>(opt.get_list<boolean_ini_t>(), opt.get_name());
-			break;
-		case option_type::enum_e:
-			validate_typed_option_items<enum_ini_t>(opt.get_list<enum_ini_t>(), opt.get_name());
-			break;
-		case option_type::float_e:
-			validate_typed_option_items<float_ini_t>(opt.get_list<float_ini_t>(), opt.get_name());
-			break;
-		case option_type::signed_e:
-			validate_typed_option_items<signed_ini_t>(opt.get_list<signed_ini_t>(), opt.get_name());
-			break;
-		case option_type::string_e:
-			validate_typed_option_items<string_ini_t>(opt.get_list<string_ini_t>(), opt.get_name());
-			break;
-		case option_type::unsigned_e:
-			validate_typed_option_items<unsigned_ini_t>(opt.get_list<unsigned_ini_t>(), opt.get_name());
-			break;
-		case option_type::date_e:
-			validate_typed_option_items<date_ini_t>(opt.get_list<date_ini_t>(), opt.get_name());
-			break;
-		case option_type::locale_e:
-			validate_typed_option_items<locale_ini_t>(opt.get_list<locale_ini_t>(), opt.get_name());
-			break;
+		case option_type::boolean_e: return parse_typed_option<boolean_ini_t>(option_name, values, alloc);
+		case option_type::enum_e: return parse_typed_option<enum_ini_t>(option_name, values, alloc);
+		case option_type::float_e: return parse_typed_option<float_ini_t>(option_name, values, alloc);
+		case option_type::signed_e: return parse_typed_option<signed_ini_t>(option_name, values, alloc);
+		case option_type::string_e: return parse_typed_option<string_ini_t>(option_name, values, alloc);
+		case option_type::unsigned_e: return parse_typed_option<unsigned_ini_t>(option_name, values, alloc);
+		case option_type::date_e: return parse_typed_option<date_ini_t>(option_name, values, alloc);
+		case option_type::locale_e: return parse_typed_option<locale_ini_t>(option_name, values, alloc);
 		case option_type::invalid_e:
 			// never reached
-			throw invalid_type_exception("Option '" + opt.get_name() + "' - invalid option type");
 			break;
 		}
+		throw invalid_type_exception("Invalid option type");
+	}
+
+	memo_statistics option_schema::get_memo_statistics() const
+	{
+		memo_caches caches;
+		collect_memo_statistics(caches);
+		return caches.empty() ? memo_statistics() : caches.begin()->second;
 	}
 
-	void option_schema::parse_option_items(option &opt) const
+	void option_schema::collect_memo_statistics(memo_caches &caches) const
 	{
 		switch (type_) {
-		case option_type::boolean_e:
-			opt.set_list<boolean_ini_t>(parse_typed_option_items<boolean_ini_t>(
-				opt.get_list<string_ini_t>(), string_utils::parse_string<boolean_ini_t>, opt.get_name()));
-			break;
-		case option_type::enum_e:
-			opt.set_list<enum_ini_t>(parse_typed_option_items<enum_ini_t>(
-				opt.get_list<string_ini_t>(), string_utils::parse_string<enum_ini_t>, opt.get_name()));
-			break;
-		case option_type::float_e:
-			opt.set_list<float_ini_t>(parse_typed_option_items<float_ini_t>(
-				opt.get_list<string_ini_t>(), string_utils::parse_string<float_ini_t>, opt.get_name()));
-			break;
-		case option_type::signed_e:
-			opt.set_list<signed_ini_t>(parse_typed_option_items<signed_ini_t>(
-				opt.get_list<string_ini_t>(), string_utils::parse_string<signed_ini_t>, opt.get_name()));
-			break;
-		case option_type::string_e:
-			// string doesn't need to be parsed
-			break;
-		case option_type::unsigned_e:
-			opt.set_list<unsigned_ini_t>(parse_typed_option_items<unsigned_ini_t>(
-				opt.get_list<string_ini_t>(), string_utils::parse_string<unsigned_ini_t>, opt.get_name()));
-			break;
-		case option_type::date_e:
-			opt.set_list<date_ini_t>(parse_typed_option_items<date_ini_t>(
-				opt.get_list<string_ini_t>(), string_utils::parse_string<date_ini_t>, opt.get_name()));
-			break;
-		case option_type::locale_e:
-			opt.set_list<locale_ini_t>(parse_typed_option_items<locale_ini_t>(
-				opt.get_list<string_ini_t>(), string_utils::parse_string<locale_ini_t>, opt.get_name()));
-			break;
+		case option_type::boolean_e: collect_typed_memo_statistics<boolean_ini_t>(*params_, caches); break;
+		case option_type::enum_e: collect_typed_memo_statistics<enum_ini_t>(*params_, caches); break;
+		case option_type::float_e: collect_typed_memo_statistics<float_ini_t>(*params_, caches); break;
+		case option_type::signed_e: collect_typed_memo_statistics<signed_ini_t>(*params_, caches); break;
+		case option_type::string_e: collect_typed_memo_statistics<string_ini_t>(*params_, caches); break;
+		case option_type::unsigned_e: collect_typed_memo_statistics<unsigned_ini_t>(*params_, caches); break;
+		case option_type::date_e: collect_typed_memo_statistics<date_ini_t>(*params_, caches); break;
+		case option_type::locale_e: collect_typed_memo_statistics<locale_ini_t>(*params_, caches); break;
 		case option_type::invalid_e:
 			// never reached
-			throw invalid_type_exception("Option '" + opt.get_name() + "' - invalid option type");
 			break;
 		}
 	}
@@ -184,6 +346,21 @@ namespace inicpp
 		// default value given at construction
 		os << ";<default value: \"" << get_default_value() << "\">" << std::endl;
 
+		// declarative constraints of values
+		switch (type_) {
+		case option_type::boolean_e: write_constraints<boolean_ini_t>(*params_, os); break;
+		case option_type::enum_e: write_constraints<enum_ini_t>(*params_, os); break;
+		case option_type::float_e: write_constraints<float_ini_t>(*params_, os); break;
+		case option_type::signed_e: write_constraints<signed_ini_t>(*params_, os); break;
+		case option_type::string_e: write_constraints<string_ini_t>(*params_, os); break;
+		case option_type::unsigned_e: write_constraints<unsigned_ini_t>(*params_, os); break;
+		case option_type::date_e: write_constraints<date_ini_t>(*params_, os); break;
+		case option_type::locale_e: write_constraints<locale_ini_t>(*params_, os); break;
+		case option_type::invalid_e:
+			// never reached
+			break;
+		}
+
 		return os;
 	}
 
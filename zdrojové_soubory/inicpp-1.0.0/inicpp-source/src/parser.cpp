@@ -1,7 +1,164 @@
 #include "parser.h"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define INICPP_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace inicpp
 {
+	namespace
+	{
+		/** Inputs smaller than this are not split for parallel loading. */
+		const size_t parallel_chunk_min_size = 64 * 1024;
+
+		/**
+		 * Retrieves line from buffer starting at position and moves position
+		 * after it. Same semantics as std::getline, last line does not have
+		 * to be terminated.
+		 */
+		bool next_line(std::string_view buffer, size_t &position, std::string &out_string)
+		{
+			if (position >= buffer.size()) {
+				return false;
+			}
+
+			const char *begin = buffer.data() + position;
+			const char *end = static_cast<const char *>(std::memchr(begin, '\n', buffer.size() - position));
+			if (end == nullptr) {
+				out_string.assign(begin, buffer.size() - position);
+				position = buffer.size();
+			} else {
+				out_string.assign(begin, end);
+				position = (end - buffer.data()) + 1;
+			}
+
+			return true;
+		}
+
+		/**
+		 * Unescapes option values into buffer of strings, which is reused
+		 * between options, so its elements may be moved from.
+		 */
+		void unescape_values(const std::vector<std::string_view> &values, std::vector<std::string> &buffer)
+		{
+			buffer.resize(values.size());
+			for (size_t i = 0; i < values.size(); ++i) {
+				buffer[i].clear();
+				string_utils::unescape(values[i], buffer[i]);
+			}
+		}
+
+		/**
+		 * Determines whether values of given buffer have to stay strings until validation.
+		 * Links are resolved on the text of their targets, which typed values do not keep.
+		 */
+		bool may_contain_links(std::string_view buffer)
+		{
+			return buffer.find("${") != std::string_view::npos;
+		}
+
+		/**
+		 * Schema of section with given name.
+		 * @return nullptr if there is no schema or it does not contain the section
+		 */
+		const section_schema *find_section_schema(const schema *schm, std::string_view section_name)
+		{
+			if (schm == nullptr || !schm->contains(section_name)) {
+				return nullptr;
+			}
+			return &(*schm)[section_name];
+		}
+
+		/**
+		 * Creates option typed by its schema, values are parsed straight from their escaped text.
+		 * @return created option or nothing if there is no option schema or some value cannot be parsed,
+		 *   option is then stored as strings and validation reports the error in its usual order
+		 */
+		std::optional<option> parse_typed_option(const section_schema *sect_schema, std::string_view option_name,
+			const std::vector<std::string_view> &values, const option::allocator_type &alloc)
+		{
+			if (sect_schema == nullptr || !sect_schema->contains(option_name)) {
+				return std::nullopt;
+			}
+			try {
+				return (*sect_schema)[option_name].parse_option(std::string(option_name), values, alloc);
+			} catch (const invalid_type_exception &) {
+				return std::nullopt;
+			}
+		}
+
+		/**
+		 * Splits buffer into at most given count of chunks of similar size,
+		 * every chunk except the first one begins with a section header line.
+		 */
+		std::vector<std::string_view> split_at_sections(std::string_view buffer, size_t count)
+		{
+			std::vector<std::string_view> chunks;
+			size_t chunk_begin = 0;
+			for (size_t i = 1; i < count; ++i) {
+				size_t pos = std::max(chunk_begin + 1, buffer.size() / count * i);
+				while (pos < buffer.size()) {
+					// move to the beginning of the next line
+					if (buffer[pos - 1] != '\n') {
+						pos = buffer.find('\n', pos);
+						if (pos == std::string_view::npos) {
+							pos = buffer.size();
+							break;
+						}
+						++pos;
+						continue;
+					}
+					size_t line_end = std::min(buffer.find('\n', pos), buffer.size());
+					if (string_utils::starts_with(string_utils::left_trim(buffer.substr(pos, line_end - pos)), "[")) {
+						break;
+					}
+					pos = line_end + 1;
+				}
+				if (pos >= buffer.size()) {
+					break;
+				}
+				chunks.push_back(buffer.substr(chunk_begin, pos - chunk_begin));
+				chunk_begin = pos;
+			}
+			chunks.push_back(buffer.substr(chunk_begin));
+			return chunks;
+		}
+	}
+
+	void parse_handler::on_section(std::string_view, size_t)
+	{
+	}
+
+	void parse_handler::on_option(std::string_view, const std::vector<std::string_view> &, size_t)
+	{
+	}
+
+	void parse_handler::on_comment(std::string_view, size_t)
+	{
+	}
+
+	void parse_handler::on_include(std::string_view)
+	{
+	}
+
+	void parse_handler::on_error(const std::string &message, size_t)
+	{
+		throw parser_exception(message);
+	}
+
 	stream_resource::stream_resource(std::istream &stream) : stream_(stream)
 	{
 	}
@@ -11,289 +168,696 @@ namespace inicpp
 		return static_cast<bool>(std::getline(stream_, out_string));
 	}
 
-	file_resource_stack::file_resource_stack(const std::string& file_name)
-		: resource_stack<std::ifstream>(get_file_stream(file_name))
+	buffer_resource::buffer_resource(std::string_view buffer) : buffer_(buffer), position_(0)
 	{
 	}
 
-	std::ifstream file_resource_stack::get_file_stream(const std::string &file_name)
+	bool buffer_resource::get_line(std::string &out_string)
 	{
-		std::ifstream result(file_name);
-		if (result.fail()) {
+		return next_line(buffer_, position_, out_string);
+	}
+
+	mapped_file::mapped_file(const std::string &file_name)
+		: data_(nullptr), size_(0), position_(0), mapped_(false)
+	{
+#ifdef INICPP_HAS_MMAP
+		int fd = open(file_name.c_str(), O_RDONLY);
+		if (fd == -1) {
 			throw parser_exception("File reading error");
 		}
-		return result;
+
+		struct stat file_stat;
+		if (fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) && file_stat.st_size > 0) {
+			void *address = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (address != MAP_FAILED) {
+				// file is read strictly from the beginning to the end
+				madvise(address, file_stat.st_size, MADV_SEQUENTIAL);
+				data_ = static_cast<const char *>(address);
+				size_ = file_stat.st_size;
+				mapped_ = true;
+			}
+		}
+		close(fd);
+
+		if (mapped_) {
+			return;
+		}
+#endif
+		// mapping is not available (or the file is empty or special), read it at once
+		read_whole_file(file_name);
 	}
 
-	std::ifstream file_resource_stack::get_resource(const std::string &file_name)
+	mapped_file::mapped_file(mapped_file &&source) : data_(nullptr), size_(0), position_(0), mapped_(false)
 	{
-		return get_file_stream(file_name);
+		operator=(std::move(source));
 	}
 
-	bool file_resource_stack::get_line(std::ifstream &resource, std::string &out_string) const
+	mapped_file &mapped_file::operator=(mapped_file &&source)
 	{
-		return static_cast<bool>(std::getline(resource, out_string));
+		if (this != &source) {
+			release();
+			size_ = source.size_;
+			position_ = source.position_;
+			mapped_ = source.mapped_;
+			buffer_ = std::move(source.buffer_);
+			// moved buffer may be on different address because of small string optimization
+			data_ = mapped_ ? source.data_ : buffer_.data();
+
+			source.data_ = nullptr;
+			source.size_ = 0;
+			source.position_ = 0;
+			source.mapped_ = false;
+		}
+		return *this;
 	}
 
-
-	size_t parser::find_first_nonescaped(const std::string &str, char ch)
+	mapped_file::~mapped_file()
 	{
-		size_t result = std::string::npos;
-		bool escaped = false;
+		release();
+	}
 
-		for (size_t i = 0; i < str.length(); ++i) {
-			if (escaped) {
-				// escaped character, do not do anything
-				escaped = false;
-			} else if (str[i] == '\\') {
-				// next character will be escaped
-				escaped = true;
-			} else if (str[i] == ch) {
-				// we tracked down non escaped character... return it
-				result = i;
-				break;
-			}
+	void mapped_file::read_whole_file(const std::string &file_name)
+	{
+		std::ifstream file(file_name, std::ios::in | std::ios::binary);
+		if (file.fail()) {
+			throw parser_exception("File reading error");
 		}
 
-		return result;
+		buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		data_ = buffer_.data();
+		size_ = buffer_.size();
 	}
 
-	size_t parser::find_last_escaped(const std::string &str, char ch)
+	void mapped_file::release()
 	{
-		size_t result = std::string::npos;
-		bool escaped = false;
-
-		for (size_t i = 0; i < str.length(); ++i) {
-			if (escaped) {
-				// escaped character, do not do anything
-				escaped = false;
-
-				if (str[i] == ch) {
-					result = i;
-				}
-			} else if (str[i] == '\\') {
-				// next character will be escaped
-				escaped = true;
-			}
+#ifdef INICPP_HAS_MMAP
+		if (mapped_) {
+			munmap(const_cast<char *>(data_), size_);
 		}
+#endif
+		data_ = nullptr;
+		size_ = 0;
+		mapped_ = false;
+	}
 
-		return result;
+	bool mapped_file::get_line(std::string &out_string)
+	{
+		return next_line(contents(), position_, out_string);
 	}
 
-	std::string parser::unescape(const std::string &str)
+	std::string_view mapped_file::contents() const
 	{
-		std::string result = str;
-		bool escaped = false;
+		return std::string_view(data_, size_);
+	}
 
-		auto it = result.begin();
-		while (it != result.end()) {
-			if (escaped) {
-				// escaped character, it should remain in string
-				escaped = false;
-			} else if (*it == '\\') {
-				// next character will be escaped, so delete escaping character
-				escaped = true;
-				it = result.erase(it);
-				continue;
-			}
+	file_resource_stack::file_resource_stack(const std::string &file_name)
+		: resource_stack<mapped_file>(mapped_file(file_name))
+	{
+	}
 
-			// we have while cycle so we have to do this manually
-			++it;
-		}
+	file_resource_stack::file_resource_stack(mapped_file &&file) : resource_stack<mapped_file>(std::move(file))
+	{
+	}
 
-		return result;
+	mapped_file file_resource_stack::get_resource(const std::string &file_name)
+	{
+		return mapped_file(file_name);
 	}
 
-	std::string parser::delete_comment(const std::string &str)
+	bool file_resource_stack::get_line(mapped_file &resource, std::string &out_string) const
 	{
-		return str.substr(0, find_first_nonescaped(str, ';'));
+		return resource.get_line(out_string);
 	}
 
-	std::vector<std::string> parser::parse_option_list(const std::string &str)
+
+	void parser::split_option_list(std::string_view str, std::vector<std::string_view> &items)
 	{
 		using namespace string_utils;
 
-		std::string searched = str;
-		std::vector<std::string> result;
+		items.clear();
 		char delim = ',';
 
-		size_t pos = find_first_nonescaped(searched, ',');
-		if (pos == std::string::npos) {
+		if (find_first_nonescaped(str, ',') == std::string::npos) {
 			// if no escaped strokes are present in given string,
 			//   try to use colon
 			delim = ':';
 		}
 
+		// single forward pass, each scan starts right after previous delimiter,
+		//   so escaping state is always clear at its beginning
+		size_t start = 0;
 		while (true) {
-			pos = find_first_nonescaped(searched, delim);
+			std::string_view searched = str.substr(start);
+			size_t pos = find_first_nonescaped(searched, delim);
 
 			// extract option value and process it
-			std::string value = searched.substr(0, pos);
-			value = left_trim(value);
-			// check if last escaped character is whitespace
-			size_t whitespace_pos = find_last_escaped(value, ' ');
-			value = right_trim(value);
-			if (whitespace_pos != std::string::npos) {
-				// last character is escaped whitespace
-				if (value.size() == whitespace_pos) {
-					value.push_back(' ');
+			std::string_view value = left_trim(searched.substr(0, pos));
+			std::string_view trimmed = right_trim(value);
+			if (trimmed.length() < value.length() && value[trimmed.length()] == ' ') {
+				// whitespace right after trimmed value is kept if it is escaped,
+				//   that is if odd number of escaping characters precedes it
+				size_t escapes = 0;
+				while (escapes < trimmed.length() && trimmed[trimmed.length() - escapes - 1] == '\\') {
+					++escapes;
+				}
+				if (escapes % 2 == 1) {
+					trimmed = value.substr(0, trimmed.length() + 1);
 				}
 			}
-			// finally unescape
-			value = unescape(value);
-
-			// save extracted and processed option value and cut searched string
-			result.push_back(value);
+			items.push_back(trimmed);
 
 			if (pos == std::string::npos) {
 				// no delimiter found
 				break;
 			}
-			searched = searched.substr(pos + 1);
+			start += pos + 1;
 		}
-
-		return result;
 	}
 
-	void parser::handle_links(
-		const config &cfg, const section &last_section, std::vector<std::string> &option_val_list, size_t line_number)
+	/**
+	 * Links are only recorded while the config is being built. When all
+	 * sections are known, they are resolved as a dependency graph: link whose
+	 * target value is another link is resolved after it, so forward references
+	 * work, cycles are detected and each target is looked up only once.
+	 */
+	class parser::link_resolver
 	{
-		using namespace string_utils;
+	private:
+		/** Value of option which refers to first value of another option. */
+		struct link {
+			/** Section of the linking option */
+			std::string section;
+			/** Position of the linking option in its section, options are only appended during loading */
+			size_t option_index;
+			/** Position of the link in list of option values */
+			size_t value_index;
+			/** Referenced section */
+			std::string sect_link;
+			/** Referenced option */
+			std::string opt_link;
+			/** Line of the linking option */
+			size_t line_number;
+		};
+
+		/** State of link during resolution. */
+		enum class link_state { unresolved, in_progress, resolved };
+
+		/** Marks target whose first value is not a link. */
+		static const size_t no_link = static_cast<size_t>(-1);
+
+		/** Option referenced by links. */
+		struct target {
+			/** Link which is the first value of this option, no_link if there is none */
+			size_t first_link = no_link;
+			/** True if value was already taken from the config */
+			bool resolved = false;
+			/** First value of the option, if it is not a link */
+			std::string value;
+		};
+
+		/** Links in the order of appearance */
+		std::vector<link> links_;
+
+		/**
+		 * Splits link in format "${section#option}" into its parts.
+		 * @return false if given value is not a link
+		 * @throws parser_exception if link has bad format
+		 */
+		static bool parse_link(
+			const std::string &value, std::string &sect_link, std::string &opt_link, size_t line_number)
+		{
+			using namespace string_utils;
+
+			if (!starts_with(value, "${") || !ends_with(value, "}")) {
+				return false;
+			}
 
-		for (auto &opt_value : option_val_list) {
-			if (starts_with(opt_value, "${") && ends_with(opt_value, "}")) {
-				std::string link = opt_value.substr(2, opt_value.length() - 3);
-				size_t delim = find_first_nonescaped(link, '#');
+			std::string_view link = std::string_view(value).substr(2, value.length() - 3);
+			size_t delim = find_first_nonescaped(link, '#');
 
-				// link always has to be in format "section#option"
-				// section and option cannot be empty
-				if (delim == std::string::npos || (delim + 1) == link.length()) {
-					throw parser_exception("Bad format of link on line " + std::to_string(line_number));
-				}
+			// link always has to be in format "section#option"
+			// section and option cannot be empty
+			if (delim == std::string::npos || (delim + 1) == link.length()) {
+				throw parser_exception("Bad format of link on line " + std::to_string(line_number));
+			}
 
-				std::string sect_link = link.substr(0, delim);
-				std::string opt_link = link.substr(delim + 1);
+			sect_link = link.substr(0, delim);
+			opt_link = link.substr(delim + 1);
 
-				if (sect_link.empty()) {
-					throw parser_exception(
-						"Section name in link cannot be empty on line " + std::to_string(line_number));
+			if (sect_link.empty()) {
+				throw parser_exception("Section name in link cannot be empty on line " + std::to_string(line_number));
+			}
+			return true;
+		}
+
+	public:
+		/**
+		 * Records links among values of option which is going to be stored.
+		 * @return number of links found
+		 * @throws parser_exception if some link has bad format
+		 */
+		size_t collect(const std::string &section_name, const std::vector<std::string> &values, size_t line_number)
+		{
+			size_t found = 0;
+			std::string sect_link;
+			std::string opt_link;
+			for (size_t i = 0; i < values.size(); ++i) {
+				if (parse_link(values[i], sect_link, opt_link, line_number)) {
+					links_.push_back({section_name, 0, i, sect_link, opt_link, line_number});
+					++found;
 				}
+			}
+			return found;
+		}
 
-				// find section with name specifid in link
-				const section *selected_section = nullptr;
-				if (last_section.get_name() == sect_link) {
-					selected_section = &last_section;
-				} else if (cfg.contains(sect_link)) {
-					selected_section = &cfg[sect_link];
-				} else {
-					throw parser_exception("Bad link on line " + std::to_string(line_number));
+		/**
+		 * Assigns stored option to the last collected links.
+		 * @param option_index position of option which contains the links in its section
+		 * @param count number of links returned by collect()
+		 */
+		void bind(size_t option_index, size_t count)
+		{
+			for (size_t i = links_.size() - count; i < links_.size(); ++i) {
+				links_[i].option_index = option_index;
+			}
+		}
+
+		/**
+		 * Appends links of following part of the config.
+		 */
+		void append(link_resolver &&other)
+		{
+			std::move(other.links_.begin(), other.links_.end(), std::back_inserter(links_));
+			other.links_.clear();
+		}
+
+		/**
+		 * Replaces all recorded links in given config by the values they refer to.
+		 * Links are checked in the order of appearance, so the reported error
+		 * does not depend on the way the config was loaded.
+		 * @throws parser_exception if link target does not exist or links form a cycle
+		 */
+		void resolve(config &cfg)
+		{
+			if (links_.empty()) {
+				return;
+			}
+
+			// options are stored contiguously, so they are reachable only when config is complete
+			std::vector<option *> sources(links_.size());
+			for (size_t i = 0; i < links_.size(); ++i) {
+				sources[i] = &cfg[links_[i].section][links_[i].option_index];
+			}
+
+			// referenced options, each one is looked up and its value copied only once
+			std::map<std::string, std::map<std::string, target, std::less<>>, std::less<>> targets;
+			std::vector<target *> link_targets(links_.size());
+			for (size_t i = 0; i < links_.size(); ++i) {
+				link_targets[i] = &targets[links_[i].sect_link][links_[i].opt_link];
+			}
+
+			// links which are the first value of referenced option have to be resolved before it
+			for (size_t i = 0; i < links_.size(); ++i) {
+				if (links_[i].value_index != 0) {
+					continue;
+				}
+				auto sect_it = targets.find(links_[i].section);
+				if (sect_it != targets.end()) {
+					auto opt_it = sect_it->second.find(sources[i]->get_name());
+					if (opt_it != sect_it->second.end()) {
+						opt_it->second.first_link = i;
+					}
 				}
+			}
 
-				// from selected section take appropriate option and set its value to options list
-				if (selected_section->contains(opt_link)) {
-					opt_value = selected_section->operator[](opt_link).get<string_ini_t>();
-				} else {
-					throw parser_exception("Option name in link not found on line " + std::to_string(line_number));
+			std::vector<link_state> states(links_.size(), link_state::unresolved);
+			std::vector<const std::string *> values(links_.size(), nullptr);
+			std::vector<size_t> stack;
+			for (size_t start = 0; start < links_.size(); ++start) {
+				// iterative depth first search, chains of links can be arbitrarily long
+				stack.push_back(start);
+				while (!stack.empty()) {
+					size_t current = stack.back();
+					if (states[current] == link_state::resolved) {
+						stack.pop_back();
+						continue;
+					}
+
+					const link &lnk = links_[current];
+					target &tgt = *link_targets[current];
+					if (tgt.first_link != no_link) {
+						if (states[tgt.first_link] == link_state::in_progress) {
+							throw parser_exception("Cyclic link on line " + std::to_string(lnk.line_number));
+						} else if (states[tgt.first_link] == link_state::unresolved) {
+							states[current] = link_state::in_progress;
+							stack.push_back(tgt.first_link);
+							continue;
+						}
+						values[current] = values[tgt.first_link];
+					} else {
+						if (!tgt.resolved) {
+							if (!cfg.contains(lnk.sect_link)) {
+								throw parser_exception("Bad link on line " + std::to_string(lnk.line_number));
+							}
+							const section &sect = cfg[lnk.sect_link];
+							if (!sect.contains(lnk.opt_link)) {
+								throw parser_exception(
+									"Option name in link not found on line " + std::to_string(lnk.line_number));
+							}
+							tgt.value = sect[lnk.opt_link].get<string_ini_t>();
+							tgt.resolved = true;
+						}
+						values[current] = &tgt.value;
+					}
+					states[current] = link_state::resolved;
+					stack.pop_back();
 				}
 			}
+
+			for (size_t i = 0; i < links_.size(); ++i) {
+				sources[i]->remove_from_list_pos(links_[i].value_index);
+				sources[i]->add_to_list<string_ini_t>(*values[i], links_[i].value_index);
+			}
+		}
+	};
+
+	/**
+	 * Builds config from parse events, links are resolved when all sections are loaded.
+	 */
+	class parser::config_handler : public parse_handler
+	{
+	private:
+		/** Builder of the config, sections and options are created in place */
+		config_builder builder_;
+		/** Links found in the config */
+		link_resolver links_;
+		/** Unescaped values of current option, kept between options to save allocations */
+		std::vector<std::string> value_buffer_;
+		/** Schema which types option values, nullptr if they are stored as strings */
+		const schema *schema_;
+		/** Schema of the current section, nullptr if there is none */
+		const section_schema *section_schema_;
+
+	public:
+		/**
+		 * Construct handler which fills given empty config.
+		 * @param cfg config which determines memory resource of loaded tree
+		 * @param schm schema which types option values, config must not contain links then
+		 */
+		explicit config_handler(config &&cfg, const schema *schm = nullptr)
+			: builder_(std::move(cfg)), schema_(schm), section_schema_(nullptr)
+		{
+		}
+
+		virtual void on_section(std::string_view name, size_t)
+		{
+			builder_.add_section(std::string(name));
+			section_schema_ = find_section_schema(schema_, name);
+		}
+
+		virtual void on_option(std::string_view name, const std::vector<std::string_view> &values, size_t line_number)
+		{
+			// values with schema are parsed into its type and stored without any strings
+			auto typed = parse_typed_option(section_schema_, name, values, builder_.last_section().get_allocator());
+			if (typed) {
+				builder_.add_option(std::move(*typed));
+				return;
+			}
+
+			// values are materialized only here, unescaped into reused buffer
+			unescape_values(values, value_buffer_);
+
+			section &last_section = builder_.last_section();
+			size_t links_found = links_.collect(last_section.get_name(), value_buffer_, line_number);
+
+			// and finally create option directly in current section,
+			// values are moved out of the buffer, buffer itself is kept for the next option
+			builder_.add_option(std::string(name), std::move(value_buffer_));
+			if (links_found > 0) {
+				links_.bind(last_section.size() - 1, links_found);
+			}
 		}
+
+		/** Resolves links and returns built config. */
+		config get_config()
+		{
+			config cfg = builder_.build();
+			links_.resolve(cfg);
+			return cfg;
+		}
+	};
+
+	config parser::create_config(const parser_options &options)
+	{
+		if (options.use_arena) {
+			return config(std::make_shared<arena>());
+		}
+		if (options.memory != nullptr) {
+			return config(config::allocator_type(options.memory));
+		}
+		return config();
+	}
+
+	config parser::internal_load(resource &res, const parser_options &options, const schema *schm)
+	{
+		config_handler handler(create_config(options), schm);
+		parse(res, handler, options);
+		return handler.get_config();
 	}
 
-	void parser::validate_identifier(const std::string &str, size_t line_number)
+	/**
+	 * Builds sections of one chunk independently of the rest of the config
+	 * and records its links. Parsing of the chunk stops at the first error.
+	 */
+	class parser::chunk_handler : public parse_handler
 	{
-		std::regex reg_expr("^[a-zA-Z.$:][-a-zA-Z0-9_~.:$ ]*$");
-		if (!std::regex_match(str, reg_expr)) {
-			throw parser_exception("Identifier contains forbidden characters on line " + std::to_string(line_number));
+	public:
+		/** Sections of the chunk in the order of appearance */
+		std::pmr::deque<section> sections;
+		/** Links found in the chunk */
+		link_resolver links;
+		/** First error of the chunk, nullptr if there is none */
+		std::exception_ptr error;
+
+	private:
+		/** Unescaped values of current option, kept between options to save allocations */
+		std::vector<std::string> value_buffer_;
+		/** Schema which types option values, nullptr if they are stored as strings */
+		const schema *schema_;
+		/** Schema of the current section, nullptr if there is none */
+		const section_schema *section_schema_;
+
+	public:
+		/**
+		 * Construct handler which allocates sections of the chunk from given resource.
+		 * @param memory resource used only by the thread of this chunk
+		 * @param schm schema which types option values, chunk must not contain links then
+		 */
+		chunk_handler(std::pmr::memory_resource *memory, const schema *schm)
+			: sections(memory), schema_(schm), section_schema_(nullptr)
+		{
 		}
+
+		virtual void on_section(std::string_view name, size_t)
+		{
+			sections.emplace_back(std::string(name));
+			section_schema_ = find_section_schema(schema_, name);
+		}
+
+		virtual void on_option(std::string_view name, const std::vector<std::string_view> &values, size_t line_number)
+		{
+			section &last_section = sections.back();
+			auto typed = parse_typed_option(section_schema_, name, values, last_section.get_allocator());
+			if (typed) {
+				last_section.add_option(std::move(*typed));
+				return;
+			}
+
+			unescape_values(values, value_buffer_);
+			size_t links_found = links.collect(last_section.get_name(), value_buffer_, line_number);
+
+			option opt(std::string(name), std::move(value_buffer_), last_section.get_allocator());
+			last_section.add_option(std::move(opt));
+			if (links_found > 0) {
+				links.bind(last_section.size() - 1, links_found);
+			}
+		}
+	};
+
+	config parser::internal_load(std::string_view buffer, const parser_options &options, const schema *schm)
+	{
+		size_t chunk_count = options.threads == 0 ? std::thread::hardware_concurrency() : options.threads;
+		chunk_count = std::min(chunk_count, buffer.size() / parallel_chunk_min_size);
+		if (chunk_count > 1) {
+			return parallel_load(buffer, chunk_count, options, schm);
+		}
+
+		buffer_resource res(buffer);
+		return internal_load(res, options, schm);
 	}
 
-	config parser::internal_load(resource &res)
+	config parser::parallel_load(
+		std::string_view buffer, size_t chunk_count, const parser_options &options, const schema *schm)
+	{
+		auto chunks = split_at_sections(buffer, chunk_count);
+
+		// line numbers of chunks have to be known before parsing for the sake of error messages
+		std::vector<size_t> line_offsets(chunks.size() + 1, 0);
+		thread_executor threads(chunks.size());
+		threads.run(chunks.size(), [&](size_t i) {
+			line_offsets[i + 1] = std::count(chunks[i].begin(), chunks[i].end(), '\n');
+		});
+		std::partial_sum(line_offsets.begin(), line_offsets.end(), line_offsets.begin());
+
+		// arena gives every chunk its own resource, its memory can be moved between them freely
+		config cfg = create_config(options);
+		std::vector<chunk_handler> handlers;
+		handlers.reserve(chunks.size());
+		for (size_t i = 0; i < chunks.size(); ++i) {
+			handlers.emplace_back(cfg.arena_ ? cfg.arena_->add_resource() : cfg.get_allocator().resource(), schm);
+		}
+		threads.run(chunks.size(), [&](size_t i) {
+			try {
+				buffer_resource res(chunks[i]);
+				internal_parse(res, handlers[i], options, line_offsets[i]);
+			} catch (...) {
+				handlers[i].error = std::current_exception();
+			}
+		});
+
+		// merge sections in order, error of the chunk comes after its sections were checked,
+		//   so the ambiguity checks and errors come in the same order as in serial loading
+		config_builder builder(std::move(cfg));
+		link_resolver links;
+		for (auto &handler : handlers) {
+			for (auto &sect : handler.sections) {
+				builder.add_section(std::move(sect));
+			}
+			if (handler.error) {
+				std::rethrow_exception(handler.error);
+			}
+			links.append(std::move(handler.links));
+		}
+
+		config built = builder.build();
+		links.resolve(built);
+		return built;
+	}
+
+	void parser::parse(resource &res, parse_handler &handler, const parser_options &options)
+	{
+		internal_parse(res, handler, options, 0);
+	}
+
+	void parser::internal_parse(resource &res, parse_handler &handler, const parser_options &options, size_t line_offset)
 	{
 		using namespace string_utils;
 
-		config cfg;
-		std::shared_ptr<section> last_section = nullptr;
+		// resource reports included files to the handler only during parsing
+		struct handler_guard {
+			resource &res;
+			handler_guard(resource &res, parse_handler &handler) : res(res)
+			{
+				res.set_handler(&handler);
+			}
+			~handler_guard()
+			{
+				res.set_handler(nullptr);
+			}
+		} guard(res, handler);
+
+		// all buffers are reused, recognition works on slices of the line
 		std::string line;
-		size_t line_number = 0;
+		std::string name;
+		std::vector<std::string_view> values;
+		bool in_section = false;
+		size_t line_number = line_offset;
+
+		auto error = [&](const std::string &message) {
+			handler.on_error(message + " on line " + std::to_string(line_number), line_number);
+		};
 
 		while (res.get_line(line)) {
 			line_number++;
 
-			// if there was comment delete it
-			line = delete_comment(line);
-			line = left_trim(line);
-
-			if (line.empty()) { // empty line
-				continue;
+			// separate comment from the rest of line
+			std::string_view line_view = line;
+			size_t comment_pos = find_first_nonescaped(line_view, ';');
+			std::string_view comment;
+			if (comment_pos != std::string::npos) {
+				comment = line_view.substr(comment_pos + 1);
+				line_view = line_view.substr(0, comment_pos);
 			}
-			else if (starts_with(line, "[")) { // start of section
-				line = right_trim(line);
-				if (ends_with(line, "]")) {
+			line_view = left_trim(line_view);
+
+			if (line_view.empty()) { // empty line
+			} else if (starts_with(line_view, "[")) { // start of section
+				line_view = right_trim(line_view);
+				in_section = false;
+				if (!ends_with(line_view, "]")) {
+					error("Section not ended");
+				} else if (line_view.length() == 2) {
 					// empty section name cannot be present
-					if (line.length() == 2) {
-						throw parser_exception("Section name cannot be empty on line " + std::to_string(line_number));
-					}
-
-					// if there is cached section, save it
-					if (last_section != nullptr) {
-						cfg.add_section(*last_section);
-					}
-
-					// extract name and validate it and finally create section object
-					std::string sect_name = unescape(line.substr(1, line.length() - 2));
-					validate_identifier(sect_name, line_number);
-					last_section = std::make_shared<section>(sect_name);
+					error("Section name cannot be empty");
 				} else {
-					throw parser_exception("Section not ended on line " + std::to_string(line_number));
+					// extract name and validate it
+					name.clear();
+					unescape(line_view.substr(1, line_view.length() - 2), name);
+					if (options.identifiers.is_valid(name)) {
+						in_section = true;
+						handler.on_section(name, line_number);
+					} else {
+						error("Identifier contains forbidden characters");
+					}
 				}
 			} else { // option
-				size_t opt_delim = find_first_nonescaped(line, '=');
+				size_t opt_delim = find_first_nonescaped(line_view, '=');
 				if (opt_delim == std::string::npos) {
-					throw parser_exception("Unknown element option expected on line " + std::to_string(line_number));
-				}
-
-				// if there is no opened section, option has no parent section
-				if (last_section == nullptr) {
-					throw parser_exception("Option not in section on line " + std::to_string(line_number));
-				}
-
-				// equals character was right at the end of line, should not be
-				if ((opt_delim + 1) == line.length()) {
-					throw parser_exception("Option value cannot be empty on line " + std::to_string(line_number));
-				}
-
-				// retrieve option name and value from line
-				std::string option_name = unescape(trim(line.substr(0, opt_delim)));
-				std::string option_val = line.substr(opt_delim + 1);
-
-				// validate option name
-				validate_identifier(option_name, line_number);
-
-				if (option_name.empty()) {
-					throw parser_exception("Option name cannot be empty on line " + std::to_string(line_number));
-				}
-
-				auto option_val_list = parse_option_list(option_val);
-				if (option_val_list.empty()) {
-					throw parser_exception("Option value cannot be empty on line " + std::to_string(line_number));
+					error("Unknown element option expected");
+				} else if (!in_section) {
+					// if there is no opened section, option has no parent section
+					error("Option not in section");
+				} else if ((opt_delim + 1) == line_view.length()) {
+					// equals character was right at the end of line, should not be
+					error("Option value cannot be empty");
+				} else {
+					// retrieve option name and value from line
+					name.clear();
+					unescape(trim(line_view.substr(0, opt_delim)), name);
+					if (options.identifiers.is_valid(name)) {
+						split_option_list(line_view.substr(opt_delim + 1), values);
+						handler.on_option(name, values, line_number);
+					} else {
+						error("Identifier contains forbidden characters");
+					}
 				}
+			}
 
-				handle_links(cfg, *last_section, option_val_list, line_number);
-
-				// and finally create option and store it in current section
-				option opt(option_name, option_val_list);
-				last_section->add_option(opt);
+			if (comment_pos != std::string::npos) {
+				handler.on_comment(comment, line_number);
 			}
 		}
+	}
 
-		// if there is cached section we have to add it to created config too
-		if (last_section != nullptr) {
-			cfg.add_section(*last_section);
-		}
+	void parser::parse(std::istream &str, parse_handler &handler, const parser_options &options)
+	{
+		stream_resource res(str);
+		parse(res, handler, options);
+	}
 
-		return cfg;
+	void parser::parse(const std::string &str, parse_handler &handler, const parser_options &options)
+	{
+		std::istringstream input(str);
+		stream_resource res(input);
+		parse(res, handler, options);
 	}
-	
+
+	void parser::parse_file(const std::string &file, parse_handler &handler, const parser_options &options)
+	{
+		file_resource_stack res(file);
+		parse(res, handler, options);
+	}
+
 	void parser::internal_save(const config &cfg, const schema &schm, std::ostream &str)
 	{
 		for (auto &sect : cfg) {
@@ -337,54 +901,71 @@ namespace inicpp
 		}
 	}
 
-	config parser::load(const std::string &str)
+	config parser::load(const std::string &str, const parser_options &options)
 	{
-		std::istringstream input(str);
-		stream_resource res(input);
-		return load(res);
+		return internal_load(std::string_view(str), options);
 	}
 
-	config parser::load(const std::string &str, const schema &schm, schema_mode mode)
+	config parser::load(const std::string &str, const schema &schm, schema_mode mode, const parser_options &options)
 	{
-		std::istringstream input(str);
-		stream_resource res(input);
-		return load(res, schm, mode);
+		// values are typed already during loading, so validation does not convert them again
+		std::string_view buffer = str;
+		config cfg = internal_load(buffer, options, may_contain_links(buffer) ? nullptr : &schm);
+		cfg.validate(schm, mode);
+		return cfg;
 	}
 
-	config parser::load(std::istream &str)
+	config parser::load(std::istream &str, const parser_options &options)
 	{
 		stream_resource res(str);
-		return load(res);
+		return load(res, options);
 	}
 
-	config parser::load(std::istream &str, const schema &schm, schema_mode mode)
+	config parser::load(std::istream &str, const schema &schm, schema_mode mode, const parser_options &options)
 	{
 		stream_resource res(str);
-		return load(res, schm, mode);
+		return load(res, schm, mode, options);
 	}
 
-	config parser::load(resource &res)
+	config parser::load(resource &res, const parser_options &options)
 	{
-		return internal_load(res);
+		return internal_load(res, options);
 	}
 
-	config parser::load(resource &res, const schema &schm, schema_mode mode)
+	config parser::load(resource &res, const schema &schm, schema_mode mode, const parser_options &options)
 	{
-		config cfg = internal_load(res);
+		config cfg = internal_load(res, options);
 		cfg.validate(schm, mode);
 		return cfg;
 	}
 
-	config parser::load_file(const std::string &file)
+	config parser::load_file(const std::string &file, const parser_options &options)
 	{
-		file_resource_stack res(file);
-		return load(res);
+		mapped_file contents(file);
+		if (options.threads != 1 && contents.contents().find("#include") == std::string_view::npos) {
+			// included files cannot be split, so only self-contained files are loaded in parallel
+			return internal_load(contents.contents(), options);
+		}
+
+		file_resource_stack res(std::move(contents));
+		return load(res, options);
 	}
 
-	config parser::load_file(const std::string &file, const schema &schm, schema_mode mode)
+	config parser::load_file(const std::string &file, const schema &schm, schema_mode mode, const parser_options &options)
 	{
-		file_resource_stack res(file);
-		return load(res, schm, mode);
+		mapped_file contents(file);
+		std::string_view buffer = contents.contents();
+		if (buffer.find("#include") != std::string_view::npos || may_contain_links(buffer)) {
+			// included files are not known in advance, so values are typed only by validation
+			file_resource_stack res(std::move(contents));
+			config cfg = load(res, options);
+			cfg.validate(schm, mode);
+			return cfg;
+		}
+
+		config cfg = internal_load(buffer, options, &schm);
+		cfg.validate(schm, mode);
+		return cfg;
 	}
 
 	void parser::save(const config &cfg, const std::string &file)
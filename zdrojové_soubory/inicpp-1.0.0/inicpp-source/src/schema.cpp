@@ -1,57 +1,94 @@
 #include "schema.h"
+#include <exception>
 
 namespace inicpp
 {
-	schema::schema()
+	void schema::push_section(std::shared_ptr<section_schema> sect)
 	{
+		sections_.push_back(sect);
+		sections_map_.emplace(std::string_view(sect->get_name()), std::move(sect));
 	}
 
-	schema::schema(const schema &source)
+	void schema::copy_sections(const schema &source)
 	{
-		// we have to do deep copies of section schemas
+		// we have to do deep copies of section schemas, allocator is passed to them by uses-allocator construction
+		std::pmr::polymorphic_allocator<section_schema> alloc(get_allocator());
 		sections_.reserve(source.sections_.size());
 		for (auto &sect : source.sections_) {
-			sections_.push_back(std::make_shared<section_schema>(*sect));
+			push_section(std::allocate_shared<section_schema>(alloc, *sect));
 		}
+	}
 
-		// we already have constructed section schemas... now push them into map
-		for (auto &sect : sections_) {
-			sections_map_.insert(sect_schema_map_pair(sect->get_name(), sect));
-		}
+	schema::schema()
+	{
+	}
+
+	schema::schema(const allocator_type &alloc) : sections_(alloc), sections_map_(alloc)
+	{
+	}
+
+	schema::schema(const schema &source) : schema(source, allocator_type())
+	{
+	}
+
+	schema::schema(const schema &source, const allocator_type &alloc) : sections_(alloc), sections_map_(alloc)
+	{
+		copy_sections(source);
 	}
 
 	schema &schema::operator=(const schema &source)
 	{
 		if (this != &source) {
-			schema new_src(source);
-			std::swap(*this, new_src);
+			sections_.clear();
+			sections_map_.clear();
+			copy_sections(source);
 		}
 
 		return *this;
 	}
 
-	schema::schema(schema &&source)
+	schema::schema(schema &&source) noexcept
+		: sections_(std::move(source.sections_)), sections_map_(std::move(source.sections_map_))
 	{
-		*this = std::move(source);
 	}
 
-	schema &schema::operator=(schema &&source)
+	schema::schema(schema &&source, const allocator_type &alloc) : sections_(alloc), sections_map_(alloc)
 	{
-		if (this != &source) {
+		if (source.get_allocator() == alloc) {
 			sections_ = std::move(source.sections_);
 			sections_map_ = std::move(source.sections_map_);
+		} else {
+			copy_sections(source);
+		}
+	}
+
+	schema &schema::operator=(schema &&source)
+	{
+		if (this != &source) {
+			if (source.get_allocator() == get_allocator()) {
+				sections_ = std::move(source.sections_);
+				sections_map_ = std::move(source.sections_map_);
+			} else {
+				sections_.clear();
+				sections_map_.clear();
+				copy_sections(source);
+			}
 		}
 
 		return *this;
 	}
 
+	schema::allocator_type schema::get_allocator() const
+	{
+		return sections_.get_allocator();
+	}
+
 	void schema::add_section(const section_schema &sect_schema)
 	{
-		auto add_it = sections_map_.find(sect_schema.get_name());
+		auto add_it = sections_map_.find(std::string_view(sect_schema.get_name()));
 		if (add_it == sections_map_.end()) {
-			std::shared_ptr<section_schema> add = std::make_shared<section_schema>(sect_schema);
-			sections_.push_back(add);
-			sections_map_.insert(sect_schema_map_pair(add->get_name(), add));
+			push_section(std::allocate_shared<section_schema>(
+				std::pmr::polymorphic_allocator<section_schema>(get_allocator()), sect_schema));
 		} else {
 			throw ambiguity_exception(sect_schema.get_name());
 		}
@@ -59,11 +96,10 @@ namespace inicpp
 
 	void schema::add_section(const section_schema_params &arguments)
 	{
-		auto add_it = sections_map_.find(arguments.name);
+		auto add_it = sections_map_.find(std::string_view(arguments.name));
 		if (add_it == sections_map_.end()) {
-			std::shared_ptr<section_schema> add = std::make_shared<section_schema>(arguments);
-			sections_.push_back(add);
-			sections_map_.insert(sect_schema_map_pair(add->get_name(), add));
+			push_section(std::allocate_shared<section_schema>(
+				std::pmr::polymorphic_allocator<section_schema>(get_allocator()), arguments));
 		} else {
 			throw ambiguity_exception(arguments.name);
 		}
@@ -71,7 +107,7 @@ namespace inicpp
 
 	void schema::add_option(const std::string &section_name, const option_schema &opt_schema)
 	{
-		auto sect_it = sections_map_.find(section_name);
+		auto sect_it = sections_map_.find(std::string_view(section_name));
 		if (sect_it != sections_map_.end()) {
 			sect_it->second->add_option(opt_schema);
 		} else {
@@ -84,6 +120,19 @@ namespace inicpp
 		return sections_.size();
 	}
 
+	memo_statistics schema::get_memo_statistics() const
+	{
+		memo_caches caches;
+		for (auto &sect : sections_) {
+			sect->collect_memo_statistics(caches);
+		}
+		memo_statistics statistics;
+		for (auto &cache : caches) {
+			statistics += cache.second;
+		}
+		return statistics;
+	}
+
 	section_schema &schema::operator[](size_t index)
 	{
 		if (index >= sections_.size()) {
@@ -102,35 +151,55 @@ namespace inicpp
 		return *sections_[index];
 	}
 
-	section_schema &schema::operator[](const std::string &section_name)
+	section_schema &schema::operator[](std::string_view section_name)
 	{
-		std::shared_ptr<section_schema> result;
-		try {
-			result = sections_map_.at(section_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(section_name);
+		return const_cast<section_schema &>(static_cast<const schema *>(this)->operator[](section_name));
+	}
+
+	const section_schema &schema::operator[](std::string_view section_name) const
+	{
+		auto sect_it = sections_map_.find(std::string_view(section_name));
+		if (sect_it == sections_map_.end()) {
+			throw not_found_exception(std::string(section_name));
 		}
-		return *result;
+		return *sect_it->second;
 	}
 
-	const section_schema &schema::operator[](const std::string &section_name) const
+	bool schema::contains(std::string_view section_name) const
 	{
-		std::shared_ptr<section_schema> result;
-		try {
-			result = sections_map_.at(section_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(section_name);
+		return sections_map_.find(section_name) != sections_map_.end();
+	}
+
+	void schema::add_missing_section(config &cfg, const section_schema &sect)
+	{
+		if (sect.is_mandatory()) {
+			// mandatory section is not present in given config (both modes)
+			throw validation_exception("Mandatory section '" + sect.get_name() + "' is missing in config");
+		}
+
+		// section is not mandatory and not in given config
+		//   => add section to config and all its options with default values
+		cfg.add_section(sect.get_name());
+		for (size_t i = 0; i < sect.size(); ++i) {
+			auto &opt = sect[i];
+			cfg.add_option(sect.get_name(), opt.get_name(), opt.get_default_value());
 		}
-		return *result;
 	}
 
-	bool schema::contains(const std::string &section_name) const
+	void schema::check_unknown_sections(const config &cfg, schema_mode mode) const
 	{
-		try {
-			sections_map_.at(section_name);
-			return true;
-		} catch (std::out_of_range) {
-			return false;
+		for (auto &sect : cfg) {
+			bool contains = this->contains(sect.get_name());
+
+			// if schema contains section everything is fine, it was validated already
+			if (contains) {
+				continue;
+			}
+
+			// we have strict mode and section which is not in schema
+			if (mode == schema_mode::strict) {
+				throw validation_exception("Section '" + sect.get_name() + "' not specified in schema");
+			}
 		}
 	}
 
@@ -146,39 +215,63 @@ namespace inicpp
 
 		// firstly go through section schemas
 		for (auto &sect : sections_) {
-			bool contains = cfg.contains(sect->get_name());
-
-			if (contains) {
+			if (cfg.contains(sect->get_name())) {
 				// even if section is not mandatory, we execute validation of section (both modes)
 				sect->validate_section(cfg[sect->get_name()], mode);
-			} else if (sect->is_mandatory()) {
-				// mandatory section is not present in given config (both modes)
-				throw validation_exception("Mandatory section '" + sect->get_name() + "' is missing in config");
 			} else {
-				// section is not mandatory and not in given config
-				//   => add section to config and all its options with default values
-				cfg.add_section(sect->get_name());
-				for (size_t i = 0; i < sect->size(); ++i) {
-					auto &opt = sect->operator[](i);
-					cfg.add_option(sect->get_name(), opt.get_name(), opt.get_default_value());
-				}
+				add_missing_section(cfg, *sect);
 			}
 		}
 
 		// secondly go through sections
-		for (auto &sect : cfg) {
-			bool contains = this->contains(sect.get_name());
+		check_unknown_sections(cfg, mode);
+	}
 
-			// if schema contains section everything is fine, we handled this above
-			if (contains) {
-				continue;
+	void schema::validate_config(config &cfg, schema_mode mode, executor &exec) const
+	{
+		// arena is not synchronized, so the tree can be changed only by one thread
+		if (cfg.arena_ != nullptr) {
+			validate_config(cfg, mode);
+			return;
+		}
+
+		// sections are independent, references to them stay valid until missing sections are added
+		std::vector<size_t> present;
+		std::vector<section *> targets;
+		for (size_t i = 0; i < sections_.size(); ++i) {
+			if (cfg.contains(sections_[i]->get_name())) {
+				present.push_back(i);
+				targets.push_back(&cfg[sections_[i]->get_name()]);
+			}
+		}
+		std::vector<std::exception_ptr> errors(sections_.size());
+		exec.run(present.size(), [&](size_t task) {
+			try {
+				sections_[present[task]]->validate_section(*targets[task], mode);
+			} catch (...) {
+				errors[present[task]] = std::current_exception();
 			}
+		});
 
-			// we have strict mode and section which is not in schema
-			if (mode == schema_mode::strict) {
-				throw validation_exception("Section '" + sect.get_name() + "' not specified in schema");
+		// errors and missing sections are handled in the order of section schemas as in serial validation
+		auto present_it = present.begin();
+		for (size_t i = 0; i < sections_.size(); ++i) {
+			if (present_it != present.end() && *present_it == i) {
+				++present_it;
+				if (errors[i]) {
+					std::rethrow_exception(errors[i]);
+				}
+			} else {
+				add_missing_section(cfg, *sections_[i]);
 			}
 		}
+
+		check_unknown_sections(cfg, mode);
+	}
+
+	compiled_schema schema::compile() const
+	{
+		return compiled_schema(*this);
 	}
 
 	std::ostream &operator<<(std::ostream &os, const schema &schm)
@@ -2,62 +2,88 @@
 
 namespace inicpp
 {
-	section::section(const section &source) : name_(source.name_)
+	section::section(const section &source) : section(source, allocator_type())
 	{
-		// we have to do deep copies of options
-		options_.reserve(source.options_.size());
-		for (auto &opt : source.options_) {
-			options_.push_back(std::make_shared<option>(*opt));
-		}
+	}
 
-		// we already have constructed options... now push them into map
-		for (auto &opt : options_) {
-			options_map_.insert(options_map_pair(opt->get_name(), opt));
-		}
+	section::section(const section &source, const allocator_type &alloc)
+		: options_(source.options_, alloc), index_(source.index_, alloc), name_(source.name_)
+	{
 	}
 
 	section &section::operator=(const section &source)
 	{
 		if (this != &source) {
-			// make copy of input source section and swap it with this
-			section new_src(source);
-			std::swap(*this, new_src);
+			options_ = source.options_;
+			index_ = source.index_;
+			name_ = source.name_;
 		}
 
 		return *this;
 	}
 
-	section::section(section &&source)
+	section::section(section &&source) noexcept
+		: options_(std::move(source.options_)), index_(std::move(source.index_)), name_(std::move(source.name_))
+	{
+	}
+
+	section::section(section &&source, const allocator_type &alloc)
+		: options_(std::move(source.options_), alloc), index_(std::move(source.index_), alloc),
+		  name_(std::move(source.name_))
 	{
-		operator=(std::move(source));
 	}
 
 	section &section::operator=(section &&source)
 	{
 		if (this != &source) {
 			options_ = std::move(source.options_);
-			options_map_ = std::move(source.options_map_);
+			index_ = std::move(source.index_);
 			name_ = std::move(source.name_);
 		}
 		return *this;
 	}
 
-	section::section(const std::string &name) : name_(name)
+	section::section(const std::string &name, const allocator_type &alloc) : options_(alloc), index_(alloc), name_(name)
 	{
 	}
 
+	section::allocator_type section::get_allocator() const
+	{
+		return options_.get_allocator();
+	}
+
 	const std::string &section::get_name() const
 	{
 		return name_;
 	}
 
+	size_t section::find_option(std::string_view option_name, uint64_t name_hash) const
+	{
+		return index_.find(
+			option_name, name_hash, [this](size_t position) -> const std::string & { return options_[position].get_name(); });
+	}
+
+	void section::push_option(option &&opt, uint64_t name_hash)
+	{
+		options_.push_back(std::move(opt));
+		index_.insert(name_hash, [this](size_t position) -> const std::string & { return options_[position].get_name(); });
+	}
+
 	void section::add_option(const option &opt)
 	{
-		auto add_it = options_map_.find(opt.get_name());
-		if (add_it == options_map_.end()) {
-			std::shared_ptr<option> add = std::make_shared<option>(opt);
-			options_.push_back(add);
-			options_map_.insert(options_map_pair(add->get_name(), add));
+		uint64_t name_hash = name_index::hash(opt.get_name());
+		if (find_option(opt.get_name(), name_hash) == name_index::npos) {
+			push_option(option(opt, options_.get_allocator()), name_hash);
+		} else {
+			throw ambiguity_exception(opt.get_name());
+		}
+	}
+
+	void section::add_option(option &&opt)
+	{
+		uint64_t name_hash = name_index::hash(opt.get_name());
+		if (find_option(opt.get_name(), name_hash) == name_index::npos) {
+			push_option(std::move(opt), name_hash);
 		} else {
 			throw ambiguity_exception(opt.get_name());
 		}
@@ -65,16 +91,12 @@ namespace inicpp
 
 	void section::remove_option(const std::string &option_name)
 	{
-		auto del_it = options_map_.find(option_name);
-		if (del_it != options_map_.end()) {
-			// remove from map
-			options_map_.erase(del_it);
-			// remove from vector
-			options_.erase(
-				std::remove_if(options_.begin(),
-					options_.end(),
-					[&](std::shared_ptr<option> opt) { return (opt->get_name() == option_name ? true : false); }),
-				options_.end());
+		size_t position = find_option(option_name, name_index::hash(option_name));
+		if (position != name_index::npos) {
+			// remove from vector and index positions of shifted options again
+			options_.erase(options_.begin() + position);
+			index_.rebuild(
+				options_.size(), [this](size_t position) -> const std::string & { return options_[position].get_name(); });
 		} else {
 			throw not_found_exception(option_name);
 		}
@@ -91,7 +113,7 @@ namespace inicpp
 			throw not_found_exception(index);
 		}
 
-		return *options_[index];
+		return options_[index];
 	}
 
 	const option &section::operator[](size_t index) const
@@ -100,39 +122,30 @@ namespace inicpp
 			throw not_found_exception(index);
 		}
 
-		return *options_[index];
+		return options_[index];
 	}
 
-	option &section::operator[](const std::string &option_name)
+	option &section::operator[](std::string_view option_name)
 	{
-		std::shared_ptr<option> result;
-		try {
-			result = options_map_.at(option_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(option_name);
+		size_t position = find_option(option_name, name_index::hash(option_name));
+		if (position == name_index::npos) {
+			throw not_found_exception(std::string(option_name));
 		}
-		return *result;
+		return options_[position];
 	}
 
-	const option &section::operator[](const std::string &option_name) const
+	const option &section::operator[](std::string_view option_name) const
 	{
-		std::shared_ptr<option> result;
-		try {
-			result = options_map_.at(option_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(option_name);
+		size_t position = find_option(option_name, name_index::hash(option_name));
+		if (position == name_index::npos) {
+			throw not_found_exception(std::string(option_name));
 		}
-		return *result;
+		return options_[position];
 	}
 
-	bool section::contains(const std::string &option_name) const
+	bool section::contains(std::string_view option_name) const
 	{
-		try {
-			options_map_.at(option_name);
-			return true;
-		} catch (std::out_of_range) {
-			return false;
-		}
+		return find_option(option_name, name_index::hash(option_name)) != name_index::npos;
 	}
 
 	void section::validate(const section_schema &sect_schema, schema_mode mode)
@@ -146,12 +159,7 @@ namespace inicpp
 			return false;
 		}
 
-		return std::equal(options_.begin(),
-			options_.end(),
-			other.options_.begin(),
-			[](const std::shared_ptr<option> &first, const std::shared_ptr<option> &second) {
-				return *first == *second;
-			});
+		return std::equal(options_.begin(), options_.end(), other.options_.begin());
 	}
 
 	bool section::operator!=(const section &other) const
@@ -193,7 +201,7 @@ namespace inicpp
 	{
 		os << "[" << sect.get_name() << "]" << std::endl;
 		for (auto &opt : sect.options_) {
-			os << *opt;
+			os << opt;
 		}
 
 		return os;
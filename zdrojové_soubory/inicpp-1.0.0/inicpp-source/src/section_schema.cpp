@@ -3,54 +3,95 @@
 
 namespace inicpp
 {
-	section_schema::section_schema(const section_schema &source)
-		: name_(source.name_), requirement_(source.requirement_), comment_(source.comment_)
+	void section_schema::push_option(std::shared_ptr<option_schema> opt)
+	{
+		options_.push_back(opt);
+		options_map_.emplace(std::string_view(opt->get_name()), std::move(opt));
+	}
+
+	void section_schema::copy_options(const section_schema &source)
 	{
 		// we have to do deep copies of option schemas
+		std::pmr::polymorphic_allocator<option_schema> alloc(get_allocator());
 		options_.reserve(source.options_.size());
 		for (auto &opt : source.options_) {
-			options_.push_back(std::make_shared<option_schema>(*opt));
+			push_option(std::allocate_shared<option_schema>(alloc, *opt));
 		}
+	}
 
-		// we already have constructed option schemas... now push them into map
-		for (auto &opt : options_) {
-			options_map_.insert(opt_schema_map_pair(opt->get_name(), opt));
-		}
+	section_schema::section_schema(const section_schema &source) : section_schema(source, allocator_type())
+	{
+	}
+
+	section_schema::section_schema(const section_schema &source, const allocator_type &alloc)
+		: name_(source.name_), requirement_(source.requirement_), comment_(source.comment_), options_(alloc),
+		  options_map_(alloc)
+	{
+		copy_options(source);
 	}
 
 	section_schema &section_schema::operator=(const section_schema &source)
 	{
 		if (this != &source) {
-			section_schema new_src(source);
-			std::swap(*this, new_src);
+			name_ = source.name_;
+			requirement_ = source.requirement_;
+			comment_ = source.comment_;
+			options_.clear();
+			options_map_.clear();
+			copy_options(source);
 		}
 
 		return *this;
 	}
 
-	section_schema::section_schema(section_schema &&source)
+	section_schema::section_schema(section_schema &&source) noexcept
+		: name_(std::move(source.name_)), requirement_(source.requirement_), comment_(std::move(source.comment_)),
+		  options_(std::move(source.options_)), options_map_(std::move(source.options_map_))
 	{
-		*this = std::move(source);
+	}
+
+	section_schema::section_schema(section_schema &&source, const allocator_type &alloc)
+		: name_(std::move(source.name_)), requirement_(source.requirement_), comment_(std::move(source.comment_)),
+		  options_(alloc), options_map_(alloc)
+	{
+		if (source.get_allocator() == alloc) {
+			options_ = std::move(source.options_);
+			options_map_ = std::move(source.options_map_);
+		} else {
+			copy_options(source);
+		}
 	}
 
 	section_schema &section_schema::operator=(section_schema &&source)
 	{
 		if (this != &source) {
 			name_ = std::move(source.name_);
-			requirement_ = std::move(source.requirement_);
+			requirement_ = source.requirement_;
 			comment_ = std::move(source.comment_);
-			options_ = std::move(source.options_);
-			options_map_ = std::move(source.options_map_);
+			if (source.get_allocator() == get_allocator()) {
+				options_ = std::move(source.options_);
+				options_map_ = std::move(source.options_map_);
+			} else {
+				options_.clear();
+				options_map_.clear();
+				copy_options(source);
+			}
 		}
 
 		return *this;
 	}
 
-	section_schema::section_schema(const section_schema_params &arguments)
-		: name_(arguments.name), requirement_(arguments.requirement), comment_(arguments.comment)
+	section_schema::section_schema(const section_schema_params &arguments, const allocator_type &alloc)
+		: name_(arguments.name), requirement_(arguments.requirement), comment_(arguments.comment), options_(alloc),
+		  options_map_(alloc)
 	{
 	}
 
+	section_schema::allocator_type section_schema::get_allocator() const
+	{
+		return options_.get_allocator();
+	}
+
 	const std::string &section_schema::get_name() const
 	{
 		return name_;
@@ -68,11 +109,10 @@ namespace inicpp
 
 	void section_schema::add_option(const option_schema &opt)
 	{
-		auto add_it = options_map_.find(opt.get_name());
+		auto add_it = options_map_.find(std::string_view(opt.get_name()));
 		if (add_it == options_map_.end()) {
-			std::shared_ptr<option_schema> add = std::make_shared<option_schema>(opt);
-			options_.push_back(add);
-			options_map_.insert(opt_schema_map_pair(add->get_name(), add));
+			push_option(std::allocate_shared<option_schema>(
+				std::pmr::polymorphic_allocator<option_schema>(get_allocator()), opt));
 		} else {
 			throw ambiguity_exception(opt.get_name());
 		}
@@ -80,7 +120,7 @@ namespace inicpp
 
 	void section_schema::remove_option(const std::string &option_name)
 	{
-		auto del_it = options_map_.find(option_name);
+		auto del_it = options_map_.find(std::string_view(option_name));
 		if (del_it != options_map_.end()) {
 			// remove from map
 			options_map_.erase(del_it);
@@ -101,6 +141,24 @@ namespace inicpp
 		return options_.size();
 	}
 
+	memo_statistics section_schema::get_memo_statistics() const
+	{
+		memo_caches caches;
+		collect_memo_statistics(caches);
+		memo_statistics statistics;
+		for (auto &cache : caches) {
+			statistics += cache.second;
+		}
+		return statistics;
+	}
+
+	void section_schema::collect_memo_statistics(memo_caches &caches) const
+	{
+		for (auto &opt : options_) {
+			opt->collect_memo_statistics(caches);
+		}
+	}
+
 	option_schema &section_schema::operator[](size_t index)
 	{
 		if (index >= size()) {
@@ -119,32 +177,25 @@ namespace inicpp
 		return *options_[index];
 	}
 
-	option_schema &section_schema::operator[](const std::string &option_name)
+	option_schema &section_schema::operator[](std::string_view option_name)
 	{
 		// its not pretty but the code is not copy pasted
 		// TODO: solve if it will be used or not
 		return const_cast<option_schema &>(static_cast<const section_schema *>(this)->operator[](option_name));
 	}
 
-	const option_schema &section_schema::operator[](const std::string &option_name) const
+	const option_schema &section_schema::operator[](std::string_view option_name) const
 	{
-		std::shared_ptr<option_schema> result;
-		try {
-			result = options_map_.at(option_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(option_name);
+		auto opt_it = options_map_.find(option_name);
+		if (opt_it == options_map_.end()) {
+			throw not_found_exception(std::string(option_name));
 		}
-		return *result;
+		return *opt_it->second;
 	}
 
-	bool section_schema::contains(const std::string &option_name) const
+	bool section_schema::contains(std::string_view option_name) const
 	{
-		try {
-			options_map_.at(option_name);
-			return true;
-		} catch (std::out_of_range) {
-			return false;
-		}
+		return options_map_.find(option_name) != options_map_.end();
 	}
 
 	void section_schema::validate_section(section &sect, schema_mode mode) const
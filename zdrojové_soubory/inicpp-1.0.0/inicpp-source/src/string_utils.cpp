@@ -1,74 +1,406 @@
 #include "string_utils.h"
 #include "exception.h"
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <iomanip>
 
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define INICPP_SIMD_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+// AVX2 code is compiled for the target attribute and used only if the CPU supports it
+#define INICPP_SIMD_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
 namespace inicpp
 {
 	namespace string_utils
 	{
 		std::string left_trim(const std::string &str)
 		{
-			auto front = std::find_if(str.begin(), str.end(), [](int c) { return !std::isspace(c); });
-			return std::string(front, str.end());
+			return std::string(left_trim(std::string_view(str)));
 		}
 
 		std::string right_trim(const std::string &str)
 		{
-			auto back = std::find_if(str.rbegin(), str.rend(), [](int c) { return !std::isspace(c); }).base();
-			return std::string(str.begin(), back);
+			return std::string(right_trim(std::string_view(str)));
 		}
 
 		std::string trim(const std::string &str)
 		{
-			auto front = std::find_if(str.begin(), str.end(), [](int c) { return !std::isspace(c); });
-			auto back = std::find_if(str.rbegin(), str.rend(), [](int c) { return !std::isspace(c); }).base();
+			return std::string(trim(std::string_view(str)));
+		}
 
-			if (back <= front) {
-				return "";
-			}
-			return std::string(front, back);
+		std::string_view left_trim(std::string_view str)
+		{
+			auto front = std::find_if(str.begin(), str.end(), [](unsigned char c) { return !std::isspace(c); });
+			str.remove_prefix(front - str.begin());
+			return str;
+		}
+
+		std::string_view right_trim(std::string_view str)
+		{
+			auto back = std::find_if(str.rbegin(), str.rend(), [](unsigned char c) { return !std::isspace(c); });
+			str.remove_suffix(back - str.rbegin());
+			return str;
+		}
+
+		std::string_view trim(std::string_view str)
+		{
+			return right_trim(left_trim(str));
 		}
 
-		bool find_needle(const std::string &haystack, const std::string &needle)
+		bool find_needle(std::string_view haystack, std::string_view needle)
 		{
-			return (haystack.find(needle) == std::string::npos ? false : true);
+			return (haystack.find(needle) == std::string_view::npos ? false : true);
 		}
 
-		bool starts_with(const std::string &str, const std::string &search_str)
+		bool starts_with(std::string_view str, std::string_view search_str)
 		{
-			size_t search_str_length = search_str.length();
+			if (search_str.length() > str.length()) {
+				return false;
+			}
 
-			if (search_str_length > str.length()) {
+			return str.compare(0, search_str.length(), search_str) == 0;
+		}
+
+		bool ends_with(std::string_view str, std::string_view search_str)
+		{
+			if (search_str.length() > str.length()) {
 				return false;
 			}
 
-			for (size_t i = 0; i < search_str_length; ++i) {
-				if (str[i] != search_str[i]) {
+			return str.compare(str.length() - search_str.length(), search_str.length(), search_str) == 0;
+		}
+
+		namespace
+		{
+			/** Escaping character used in ini format. */
+			const char escape_char = '\\';
+
+			/**
+			 * Bit masks describing one 64 byte block of the scanned string,
+			 * bit i corresponds to the i-th character of the block.
+			 */
+			struct block_masks {
+				/** Positions of escaping characters */
+				uint64_t backslashes;
+				/** Positions of searched character */
+				uint64_t matches;
+			};
+
+			/** Function which fills masks for given 64 bytes long block. */
+			using block_scanner = block_masks (*)(const char *block, char ch);
+
+#ifdef INICPP_SIMD_SSE2
+			block_masks scan_block_sse2(const char *block, char ch)
+			{
+				const __m128i backslash_vec = _mm_set1_epi8(escape_char);
+				const __m128i ch_vec = _mm_set1_epi8(ch);
+				block_masks result = {0, 0};
+
+				for (int i = 0; i < 4; ++i) {
+					__m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+					uint64_t backslashes = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, backslash_vec)));
+					uint64_t matches = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, ch_vec)));
+					result.backslashes |= backslashes << (16 * i);
+					result.matches |= matches << (16 * i);
+				}
+
+				return result;
+			}
+#endif
+
+#ifdef INICPP_SIMD_AVX2
+			__attribute__((target("avx2"))) block_masks scan_block_avx2(const char *block, char ch)
+			{
+				const __m256i backslash_vec = _mm256_set1_epi8(escape_char);
+				const __m256i ch_vec = _mm256_set1_epi8(ch);
+				block_masks result = {0, 0};
+
+				for (int i = 0; i < 2; ++i) {
+					__m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32 * i));
+					uint64_t backslashes =
+						static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, backslash_vec)));
+					uint64_t matches = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, ch_vec)));
+					result.backslashes |= backslashes << (32 * i);
+					result.matches |= matches << (32 * i);
+				}
+
+				return result;
+			}
+#endif
+
+			/**
+			 * Selects the best block scanner supported by current CPU.
+			 * @return nullptr if no vectorized scanner is available
+			 */
+			block_scanner select_block_scanner()
+			{
+#ifdef INICPP_SIMD_AVX2
+				if (__builtin_cpu_supports("avx2")) {
+					return scan_block_avx2;
+				}
+#endif
+#ifdef INICPP_SIMD_SSE2
+				return scan_block_sse2;
+#else
+				return nullptr;
+#endif
+			}
+
+			/** Block scanner chosen once on the first use. */
+			block_scanner get_block_scanner()
+			{
+				static const block_scanner scanner = select_block_scanner();
+				return scanner;
+			}
+
+			/**
+			 * Computes which characters of the block are escaped, ie. preceded
+			 * by odd number of escaping characters. Runs of escaping characters
+			 * are resolved by adding sequence starts to the runs, the carry
+			 * tells whether the first character of next block is escaped.
+			 * @param backslashes positions of escaping characters in the block
+			 * @param prev_escaped 1 if first character is escaped, updated for next block
+			 * @return mask of escaped characters
+			 */
+			uint64_t find_escaped(uint64_t backslashes, uint64_t &prev_escaped)
+			{
+				const uint64_t even_bits = 0x5555555555555555ULL;
+
+				// escaped escaping character does not escape anything
+				backslashes &= ~prev_escaped;
+				uint64_t follows_escape = (backslashes << 1) | prev_escaped;
+				uint64_t odd_sequence_starts = backslashes & ~even_bits & ~follows_escape;
+				uint64_t sequences_starting_on_even_bits = odd_sequence_starts + backslashes;
+				prev_escaped = (sequences_starting_on_even_bits < odd_sequence_starts) ? 1 : 0;
+				uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+
+				return (even_bits ^ invert_mask) & follows_escape;
+			}
+
+			/**
+			 * Walks through the string in 64 byte blocks and calls @a visitor
+			 * with mask of escaped characters and mask of searched characters.
+			 * Incomplete last block is padded by zeros. Scanning ends if visitor
+			 * returns false.
+			 */
+			template <typename Visitor>
+			void scan_blocks(block_scanner scanner, std::string_view str, char ch, Visitor visitor)
+			{
+				uint64_t prev_escaped = 0;
+				size_t offset = 0;
+
+				for (; offset + 64 <= str.length(); offset += 64) {
+					block_masks masks = scanner(str.data() + offset, ch);
+					uint64_t escaped = find_escaped(masks.backslashes, prev_escaped);
+					if (!visitor(offset, escaped, masks.matches)) {
+						return;
+					}
+				}
+
+				size_t rest = str.length() - offset;
+				if (rest > 0) {
+					char block[64] = {0};
+					std::memcpy(block, str.data() + offset, rest);
+					block_masks masks = scanner(block, ch);
+					uint64_t valid = (uint64_t(1) << rest) - 1;
+					uint64_t escaped = find_escaped(masks.backslashes & valid, prev_escaped);
+					visitor(offset, escaped & valid, masks.matches & valid);
+				}
+			}
+
+			/** Index of the lowest set bit, @a mask cannot be zero. */
+			size_t lowest_bit(uint64_t mask)
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				return __builtin_ctzll(mask);
+#else
+				size_t result = 0;
+				while ((mask & 1) == 0) {
+					mask >>= 1;
+					++result;
+				}
+				return result;
+#endif
+			}
+
+			/** Index of the highest set bit, @a mask cannot be zero. */
+			size_t highest_bit(uint64_t mask)
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				return 63 - __builtin_clzll(mask);
+#else
+				size_t result = 63;
+				while ((mask & (uint64_t(1) << 63)) == 0) {
+					mask <<= 1;
+					--result;
+				}
+				return result;
+#endif
+			}
+
+			/** Strings shorter than this are not worth vectorized scanning. */
+			const size_t simd_threshold = 16;
+		}
+
+		size_t find_first_nonescaped(std::string_view str, char ch)
+		{
+			block_scanner scanner = get_block_scanner();
+			if (scanner != nullptr && str.length() >= simd_threshold && ch != escape_char) {
+				size_t result = std::string::npos;
+				scan_blocks(scanner, str, ch, [&](size_t offset, uint64_t escaped, uint64_t matches) {
+					uint64_t found = matches & ~escaped;
+					if (found == 0) {
+						return true;
+					}
+					result = offset + lowest_bit(found);
 					return false;
+				});
+				return result;
+			}
+
+			size_t result = std::string::npos;
+			bool escaped = false;
+
+			for (size_t i = 0; i < str.length(); ++i) {
+				if (escaped) {
+					// escaped character, do not do anything
+					escaped = false;
+				} else if (str[i] == escape_char) {
+					// next character will be escaped
+					escaped = true;
+				} else if (str[i] == ch) {
+					// we tracked down non escaped character... return it
+					result = i;
+					break;
 				}
 			}
 
-			return true;
+			return result;
 		}
 
-		bool ends_with(const std::string &str, const std::string &search_str)
+		size_t find_last_escaped(std::string_view str, char ch)
 		{
-			size_t search_str_length = search_str.length();
-			size_t str_length = str.length();
+			block_scanner scanner = get_block_scanner();
+			if (scanner != nullptr && str.length() >= simd_threshold) {
+				size_t result = std::string::npos;
+				scan_blocks(scanner, str, ch, [&](size_t offset, uint64_t escaped, uint64_t matches) {
+					uint64_t found = matches & escaped;
+					if (found != 0) {
+						result = offset + highest_bit(found);
+					}
+					return true;
+				});
+				return result;
+			}
 
-			if (search_str_length > str.length()) {
-				return false;
+			size_t result = std::string::npos;
+			bool escaped = false;
+
+			for (size_t i = 0; i < str.length(); ++i) {
+				if (escaped) {
+					// escaped character, do not do anything
+					escaped = false;
+
+					if (str[i] == ch) {
+						result = i;
+					}
+				} else if (str[i] == escape_char) {
+					// next character will be escaped
+					escaped = true;
+				}
 			}
 
-			for (size_t i = 0; i < search_str_length; ++i) {
-				if (str[str_length - i - 1] != search_str[search_str_length - i - 1]) {
-					return false;
+			return result;
+		}
+
+		void unescape(std::string_view str, std::string &out)
+		{
+			// vectorized memchr finds out quickly whether there is anything to do
+			const char *src = str.data();
+			const char *end = str.data() + str.length();
+			const char *next = static_cast<const char *>(std::memchr(src, escape_char, str.length()));
+			if (next == nullptr) {
+				out.append(str.data(), str.length());
+				return;
+			}
+
+			// unescaped string is never longer than the escaped one
+			size_t out_start = out.length();
+			out.resize(out_start + str.length());
+			char *dst = &out[out_start];
+
+			while (next != nullptr) {
+				size_t chunk = next - src;
+				std::memcpy(dst, src, chunk);
+				dst += chunk;
+
+				// drop escaping character and take the escaped one as it is
+				if (next + 1 < end) {
+					*dst++ = next[1];
+					src = next + 2;
+				} else {
+					src = end;
 				}
+				next = static_cast<const char *>(std::memchr(src, escape_char, end - src));
 			}
 
-			return true;
+			std::memcpy(dst, src, end - src);
+			dst += end - src;
+			out.resize(dst - out.data());
+		}
+
+		std::string unescape(std::string_view str)
+		{
+			std::string result;
+			unescape(str, result);
+			return result;
+		}
+
+		void escape(std::string_view str, std::string &out)
+		{
+			auto is_special = [](char ch) { return ch == escape_char || ch == ',' || ch == ':' || ch == ';'; };
+			auto is_space = [](char ch) { return std::isspace(static_cast<unsigned char>(ch)) != 0; };
+
+			// first pass counts escaped characters, so the output is allocated exactly once
+			size_t length = str.length();
+			size_t count = std::count_if(str.begin(), str.end(), is_special);
+			bool escape_front = length > 0 && is_space(str[0]);
+			bool escape_back = length > 1 && is_space(str[length - 1]);
+			count += (escape_front ? 1 : 0) + (escape_back ? 1 : 0);
+
+			if (count == 0) {
+				out.append(str.data(), length);
+				return;
+			}
+
+			size_t out_start = out.length();
+			out.resize(out_start + length + count);
+			char *dst = &out[out_start];
+			for (size_t i = 0; i < length; ++i) {
+				if (is_special(str[i]) || (i == 0 && escape_front) || (i == length - 1 && escape_back)) {
+					*dst++ = escape_char;
+				}
+				*dst++ = str[i];
+			}
+		}
+
+		std::string escape(std::string_view str)
+		{
+			std::string result;
+			escape(str, result);
+			return result;
+		}
+
+		const char *format_boolean(boolean_ini_t value)
+		{
+			return value ? "yes" : "no";
 		}
 
 		std::vector<std::string> split(const std::string &str, char delim)
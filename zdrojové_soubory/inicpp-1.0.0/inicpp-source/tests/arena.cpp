@@ -0,0 +1,118 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+#include "arena.h"
+#include "config.h"
+#include "parser.h"
+
+using namespace inicpp;
+
+
+TEST(arena, resources)
+{
+	arena first;
+	arena second;
+	std::pmr::memory_resource *main = first.get_resource();
+	std::pmr::memory_resource *other = first.add_resource();
+	EXPECT_EQ(main, first.get_resource());
+	EXPECT_NE(main, other);
+
+	// resources of one arena are interchangeable, resources of different arenas are not
+	EXPECT_TRUE(main->is_equal(*other));
+	EXPECT_TRUE(other->is_equal(*main));
+	EXPECT_FALSE(main->is_equal(*second.get_resource()));
+	EXPECT_FALSE(main->is_equal(*std::pmr::get_default_resource()));
+
+	// memory from one resource can be handed over to another one
+	std::pmr::vector<int> numbers({1, 2, 3}, main);
+	std::pmr::vector<int> moved(std::move(numbers), other);
+	EXPECT_EQ(moved, std::pmr::vector<int>({1, 2, 3}));
+	EXPECT_TRUE(numbers.empty());
+}
+
+TEST(arena, arena_loading)
+{
+	std::string str;
+	for (int i = 0; i < 3000; ++i) {
+		str += "[section" + std::to_string(i) + "]\n";
+		str += "single = " + std::to_string(i) + "\n";
+		str += "list = a, b, c, d, e, f, g, h, i, j\n";
+		str += "link = ${section0#single}\n";
+	}
+
+	parser_options options;
+	options.use_arena = true;
+	config expected = parser::load(str);
+	config cfg = parser::load(str, options);
+	EXPECT_TRUE(cfg == expected);
+
+	// whole tree uses memory of the config
+	std::pmr::memory_resource *memory = cfg.get_allocator().resource();
+	EXPECT_NE(memory, std::pmr::get_default_resource());
+	EXPECT_EQ(cfg["section2999"].get_allocator(), cfg.get_allocator());
+	EXPECT_EQ(cfg["section2999"]["list"].get_allocator(), cfg.get_allocator());
+	EXPECT_EQ(expected.get_allocator().resource(), std::pmr::get_default_resource());
+
+	// parallel loading fills the same arena by several threads
+	options.threads = 4;
+	config parallel = parser::load(str, options);
+	EXPECT_TRUE(parallel == expected);
+	EXPECT_NE(parallel.get_allocator().resource(), std::pmr::get_default_resource());
+	EXPECT_EQ(parallel["section2999"]["list"].get_allocator(), parallel.get_allocator());
+
+	// modification after loading stays in the arena
+	cfg.add_section("added");
+	cfg.add_option<signed_ini_t>("added", "number", 5);
+	EXPECT_EQ(cfg["added"].get_allocator(), cfg.get_allocator());
+	EXPECT_EQ(cfg["added"]["number"].get_allocator(), cfg.get_allocator());
+
+	// copies and assigned configs do not depend on the arena
+	config copy(cfg);
+	EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+	config assigned;
+	assigned = std::move(parallel);
+	EXPECT_EQ(assigned.get_allocator().resource(), std::pmr::get_default_resource());
+	EXPECT_EQ(assigned["section2999"]["list"].get_allocator().resource(), std::pmr::get_default_resource());
+	EXPECT_TRUE(assigned == expected);
+}
+
+TEST(arena, moving_between_threads)
+{
+	parser_options options;
+	options.use_arena = true;
+	config cfg = parser::load("[sect]\nopt = value\nlist = 1, 2, 3, 4, 5, 6, 7, 8, 9, 10\n", options);
+	std::pmr::memory_resource *memory = cfg.get_allocator().resource();
+
+	// moved config takes the arena with it and can be used by the other thread
+	signed_ini_t sum = 0;
+	std::thread worker([moved = std::move(cfg), &sum]() mutable {
+		for (int i = 0; i < 100; ++i) {
+			moved["sect"].add_option<string_ini_t>("added" + std::to_string(i), "text");
+		}
+		for (auto value : moved["sect"]["list"].get_view<string_ini_t>()) {
+			sum += std::stoll(value);
+		}
+	});
+
+	// moved from config does not allocate from the arena anymore, so it is reused meanwhile
+	EXPECT_NE(cfg.get_allocator().resource(), memory);
+	EXPECT_EQ(cfg.get_allocator().resource(), std::pmr::get_default_resource());
+	for (int i = 0; i < 100; ++i) {
+		cfg.add_section("other" + std::to_string(i));
+	}
+	worker.join();
+	EXPECT_EQ(sum, 55);
+	EXPECT_EQ(cfg.size(), 100u);
+
+	// the same holds for move assignment
+	config loaded = parser::load("[sect]\nopt = value\n", options);
+	config assigned;
+	assigned = std::move(loaded);
+	EXPECT_EQ(loaded.get_allocator().resource(), std::pmr::get_default_resource());
+	loaded.add_section("other");
+	EXPECT_EQ(loaded.size(), 1u);
+	EXPECT_EQ(assigned["sect"]["opt"].get<string_ini_t>(), "value");
+}
@@ -0,0 +1,147 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "compiled_schema.h"
+#include "config.h"
+#include "parser.h"
+#include "schema.h"
+
+using namespace inicpp;
+
+
+namespace
+{
+	/** Schema with mandatory and optional sections and options of several types */
+	schema create_schema()
+	{
+		schema schm;
+		section_schema_params sect_params;
+		sect_params.name = "main";
+		schm.add_section(sect_params);
+		sect_params.name = "defaults";
+		sect_params.requirement = item_requirement::optional;
+		schm.add_section(sect_params);
+
+		option_schema_params<signed_ini_t> number_params;
+		number_params.name = "number";
+		number_params.validator = [](signed_ini_t value) { return value < 100; };
+		schm.add_option("main", number_params);
+		option_schema_params<unsigned_ini_t> list_params;
+		list_params.name = "list";
+		list_params.type = option_item::list;
+		schm.add_option("main", list_params);
+		option_schema_params<string_ini_t> text_params;
+		text_params.name = "text";
+		text_params.requirement = item_requirement::optional;
+		text_params.default_value = "text";
+		text_params.validator = [](const string_ini_t &value) { return !value.empty(); };
+		schm.add_option("main", text_params);
+		schm.add_option("defaults", text_params);
+		return schm;
+	}
+}
+
+
+TEST(compiled_schema, name_tables)
+{
+	schema schm;
+	section_schema_params sect_params;
+	option_schema_params<string_ini_t> opt_params;
+	opt_params.requirement = item_requirement::optional;
+	for (int i = 0; i < 1000; ++i) {
+		sect_params.name = "section" + std::to_string(i);
+		schm.add_section(sect_params);
+		for (int j = 0; j < i % 7; ++j) {
+			opt_params.name = "option" + std::to_string(j);
+			schm.add_option(sect_params.name, opt_params);
+		}
+	}
+
+	compiled_schema plan = schm.compile();
+	EXPECT_EQ(plan.size(), 1000u);
+	for (int i = 0; i < 1000; ++i) {
+		EXPECT_TRUE(plan.contains("section" + std::to_string(i)));
+	}
+	EXPECT_FALSE(plan.contains("section1000"));
+	EXPECT_FALSE(plan.contains(""));
+	std::string buffer = "section12section";
+	EXPECT_TRUE(plan.contains(std::string_view(buffer).substr(0, 9)));
+	EXPECT_FALSE(plan.contains(std::string_view(buffer).substr(9)));
+
+	// plan does not depend on the schema
+	section_schema_params added_params;
+	added_params.name = "added";
+	schm.add_section(added_params);
+	EXPECT_FALSE(plan.contains("added"));
+	EXPECT_FALSE(compiled_schema(schema()).contains("section0"));
+}
+
+TEST(compiled_schema, validation)
+{
+	schema schm = create_schema();
+	compiled_schema plan = schm.compile();
+
+	// result is the same as validation by schema
+	config expected = parser::load("[main]\nnumber = 42\nlist = 1, 2, 3\ntext = 7\n[other]\nopt = val\n");
+	config cfg = expected;
+	schm.validate_config(expected, schema_mode::relaxed);
+	cfg.validate(plan, schema_mode::relaxed);
+	EXPECT_TRUE(cfg == expected);
+	EXPECT_EQ(cfg["main"]["number"].get_ref<signed_ini_t>(), 42);
+	EXPECT_EQ(cfg["main"]["list"].get_list<unsigned_ini_t>(), std::vector<unsigned_ini_t>({1, 2, 3}));
+	EXPECT_EQ(cfg["defaults"]["text"].get<string_ini_t>(), "text");
+	EXPECT_EQ(cfg.size(), 3u);
+
+	// validated config stays valid
+	EXPECT_NO_THROW(plan.validate_config(cfg, schema_mode::relaxed));
+	EXPECT_TRUE(cfg == expected);
+
+	// errors
+	std::vector<std::string> invalid = {
+		"[main]\nnumber = 42\nlist = 1, 2\n[other]\nopt = val\n", // unknown section in strict mode
+		"[main]\nnumber = 42\nlist = 1, 2\nother = val\n",        // unknown option in strict mode
+		"[defaults]\ntext = val\n",                                // missing mandatory section
+		"[main]\nlist = 1, 2\n",                                   // missing mandatory option
+		"[main]\nnumber = 142\nlist = 1, 2\n",                     // validator fails
+		"[main]\nnumber = 1, 2\nlist = 1, 2\n",                    // list instead of single value
+		"[main]\nnumber = 1\nlist = 1\n",                          // single value instead of list
+		"[main]\nnumber = text\nlist = 1, 2\n",                    // value of wrong type
+	};
+	for (auto &str : invalid) {
+		config invalid_cfg = parser::load(str);
+		EXPECT_THROW(plan.validate_config(invalid_cfg, schema_mode::strict), exception);
+	}
+	config relaxed = parser::load(invalid[1]);
+	EXPECT_NO_THROW(plan.validate_config(relaxed, schema_mode::relaxed));
+}
+
+TEST(compiled_schema, concurrent_validation)
+{
+	compiled_schema plan = create_schema().compile();
+
+	// one plan validates configs in several threads at once
+	std::vector<config> configs;
+	for (int i = 0; i < 40; ++i) {
+		configs.push_back(parser::load("[main]\nnumber = " + std::to_string(i) + "\nlist = 5, 6\n"));
+	}
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < 4; ++t) {
+		threads.emplace_back([&plan, &configs, t]() {
+			for (size_t i = t; i < configs.size(); i += 4) {
+				configs[i].validate(plan, schema_mode::strict);
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	for (size_t i = 0; i < configs.size(); ++i) {
+		EXPECT_EQ(configs[i]["main"]["number"].get_ref<signed_ini_t>(), static_cast<signed_ini_t>(i));
+		EXPECT_EQ(configs[i]["main"]["list"].get_list<unsigned_ini_t>(), std::vector<unsigned_ini_t>({5, 6}));
+		EXPECT_TRUE(configs[i].contains("defaults"));
+	}
+}
@@ -25,6 +25,33 @@ TEST(config, creation_and_assignments)
 	EXPECT_TRUE(move_assigned == conf);
 }
 
+TEST(config, memory_resources)
+{
+	std::pmr::monotonic_buffer_resource memory;
+	config conf((config::allocator_type(&memory)));
+	conf.add_section("sect");
+	conf.add_option<signed_ini_t>("sect", "number", 5);
+	conf.add_option("sect", option("list", std::vector<std::string>{"a", "b", "c", "d", "e", "f", "g", "h", "i"}));
+
+	// sections and options are created with resource of the config
+	EXPECT_EQ(conf.get_allocator().resource(), &memory);
+	EXPECT_EQ(conf["sect"].get_allocator().resource(), &memory);
+	EXPECT_EQ(conf["sect"]["number"].get_allocator().resource(), &memory);
+	EXPECT_EQ(conf["sect"]["list"].get_allocator().resource(), &memory);
+
+	// copy uses default resource unless other is given
+	config copy(conf);
+	EXPECT_TRUE(copy == conf);
+	EXPECT_EQ(copy["sect"]["list"].get_allocator().resource(), std::pmr::get_default_resource());
+	config other_copy(conf, config::allocator_type(&memory));
+	EXPECT_EQ(other_copy["sect"]["list"].get_allocator().resource(), &memory);
+
+	// assignment keeps resource of the target
+	copy = std::move(conf);
+	EXPECT_EQ(copy["sect"]["list"].get_allocator().resource(), std::pmr::get_default_resource());
+	EXPECT_TRUE(copy == other_copy);
+}
+
 TEST(config, adding_and_removing_sections)
 {
 	config conf;
@@ -59,6 +86,29 @@ TEST(config, adding_and_removing_options)
 	EXPECT_EQ(conf["sect"][0].get_name(), "opt2");
 }
 
+TEST(config, string_view_lookup)
+{
+	config conf;
+	conf.add_section("sect");
+	conf.add_option<string_ini_t>("sect", "opt_key", "value");
+
+	// names given as views into larger buffer, no temporary strings are needed
+	std::string buffer = "sectopt_keymissing";
+	std::string_view sect_name = std::string_view(buffer).substr(0, 4);
+	std::string_view opt_name = std::string_view(buffer).substr(4, 7);
+	std::string_view missing = std::string_view(buffer).substr(11);
+	EXPECT_TRUE(conf.contains(sect_name));
+	EXPECT_FALSE(conf.contains(missing));
+	EXPECT_TRUE(conf[sect_name].contains(opt_name));
+	EXPECT_FALSE(conf[sect_name].contains(missing));
+	EXPECT_EQ(conf[sect_name][opt_name].get<string_ini_t>(), "value");
+	EXPECT_THROW(conf[missing], not_found_exception);
+	EXPECT_THROW(conf[sect_name][missing], not_found_exception);
+
+	const config &const_conf = conf;
+	EXPECT_EQ(const_conf[sect_name][opt_name].get_name(), "opt_key");
+}
+
 TEST(config, iterators)
 {
 	config conf;
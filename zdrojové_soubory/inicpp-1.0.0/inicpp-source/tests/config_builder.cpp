@@ -0,0 +1,76 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+
+#include "config_builder.h"
+
+using namespace inicpp;
+
+
+TEST(config_builder, building_config)
+{
+	config_builder builder;
+	EXPECT_THROW(builder.last_section(), not_found_exception);
+	EXPECT_THROW(builder.add_option(option("name", "value")), not_found_exception);
+
+	// sections and options are appended to the end
+	section &first = builder.add_section("first");
+	EXPECT_EQ(first.get_name(), "first");
+	option &opt = builder.add_option("list", {"a", "b", "c"});
+	EXPECT_EQ(opt.get_list<string_ini_t>(), std::vector<string_ini_t>({"a", "b", "c"}));
+	builder.add_option(option("single", "value"));
+	EXPECT_THROW(builder.add_section("first"), ambiguity_exception);
+	EXPECT_THROW(builder.add_option(option("single", "other")), ambiguity_exception);
+
+	section second("second");
+	second.add_option<signed_ini_t>("number", 5);
+	builder.add_section(std::move(second));
+	EXPECT_EQ(builder.last_section().get_name(), "second");
+	builder.add_option("other", {"value"});
+	EXPECT_EQ(builder.size(), 2u);
+
+	// built config contains everything and builder is empty afterwards
+	config cfg = builder.build();
+	EXPECT_EQ(builder.size(), 0u);
+	EXPECT_EQ(cfg.size(), 2u);
+	EXPECT_EQ(cfg["first"].size(), 2u);
+	EXPECT_EQ(cfg["first"]["single"].get<string_ini_t>(), "value");
+	EXPECT_EQ(cfg["second"]["number"].get<signed_ini_t>(), 5);
+	EXPECT_EQ(cfg["second"]["other"].get<string_ini_t>(), "value");
+
+	// builder can be reused and continue with existing config
+	builder.add_section("first");
+	EXPECT_EQ(builder.build().size(), 1u);
+	config_builder appending(std::move(cfg));
+	EXPECT_THROW(appending.add_section("second"), ambiguity_exception);
+	appending.add_section("third");
+	config appended = appending.build();
+	EXPECT_EQ(appended.size(), 3u);
+	EXPECT_EQ(appended[2].get_name(), "third");
+}
+
+TEST(config_builder, memory_resources)
+{
+	std::pmr::monotonic_buffer_resource memory;
+	config_builder builder((config_builder::allocator_type(&memory)));
+	EXPECT_EQ(builder.get_allocator().resource(), &memory);
+
+	// created sections and options use resource of the builder
+	builder.add_section("sect");
+	builder.add_option("list", {"a", "b", "c", "d", "e", "f", "g", "h", "i"});
+	EXPECT_EQ(builder.last_section().get_allocator().resource(), &memory);
+	EXPECT_EQ(builder.last_section()["list"].get_allocator().resource(), &memory);
+
+	// moved sections are copied into the resource if they use other one
+	section other("other");
+	other.add_option<signed_ini_t>("number", 5);
+	builder.add_section(std::move(other));
+	EXPECT_EQ(builder.last_section().get_allocator().resource(), &memory);
+	EXPECT_EQ(builder.last_section()["number"].get_allocator().resource(), &memory);
+
+	config cfg = builder.build();
+	EXPECT_EQ(cfg.get_allocator().resource(), &memory);
+	EXPECT_EQ(builder.get_allocator().resource(), &memory);
+	EXPECT_EQ(cfg["other"]["number"].get<signed_ini_t>(), 5);
+}
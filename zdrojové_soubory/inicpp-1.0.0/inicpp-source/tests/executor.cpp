@@ -0,0 +1,30 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "executor.h"
+
+using namespace inicpp;
+
+
+TEST(executor, thread_executor)
+{
+	thread_executor executor(4);
+	EXPECT_EQ(executor.get_threads(), 4u);
+	EXPECT_GT(thread_executor().get_threads(), 0u);
+
+	// every task is run exactly once
+	std::vector<std::atomic<int>> runs(1000);
+	executor.run(runs.size(), [&runs](size_t i) { runs[i]++; });
+	for (auto &count : runs) {
+		EXPECT_EQ(count.load(), 1);
+	}
+
+	// empty batch and batch smaller than number of threads
+	executor.run(0, [](size_t) { FAIL(); });
+	std::atomic<size_t> sum(0);
+	executor.run(2, [&sum](size_t i) { sum += i + 1; });
+	EXPECT_EQ(sum.load(), 3u);
+}
@@ -0,0 +1,197 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "memoized_validator.h"
+#include "parser.h"
+#include "schema.h"
+
+using namespace inicpp;
+
+
+TEST(memoized_validator, remembering_results)
+{
+	size_t calls = 0;
+	memoized_validator<signed_ini_t> validator(
+		[&calls](signed_ini_t value) {
+			++calls;
+			return value % 2 == 0;
+		},
+		2);
+
+	// repeated values are validated once
+	EXPECT_TRUE(validator(2));
+	EXPECT_FALSE(validator(3));
+	EXPECT_TRUE(validator(2));
+	EXPECT_FALSE(validator(3));
+	EXPECT_EQ(calls, 2u);
+	memo_statistics statistics = validator.statistics();
+	EXPECT_EQ(statistics.hits, 2u);
+	EXPECT_EQ(statistics.misses, 2u);
+	EXPECT_EQ(statistics.evictions, 0u);
+	EXPECT_EQ(statistics.size, 2u);
+
+	// the least recently used value is forgotten, results stay the same
+	EXPECT_TRUE(validator(2));
+	EXPECT_TRUE(validator(4));
+	EXPECT_EQ(validator.statistics().evictions, 1u);
+	EXPECT_TRUE(validator(2));
+	EXPECT_EQ(calls, 3u);
+	EXPECT_FALSE(validator(3));
+	EXPECT_EQ(calls, 4u);
+
+	// copies share the cache
+	memoized_validator<signed_ini_t> copy = validator;
+	EXPECT_FALSE(copy(3));
+	EXPECT_EQ(calls, 4u);
+	copy.clear();
+	EXPECT_EQ(validator.statistics().size, 0u);
+	EXPECT_FALSE(validator(3));
+	EXPECT_EQ(calls, 5u);
+}
+
+TEST(memoized_validator, special_values)
+{
+	size_t calls = 0;
+	memoized_validator<float_ini_t> floats(
+		[&calls](float_ini_t value) {
+			++calls;
+			return !std::isnan(value) && !std::signbit(value);
+		},
+		10);
+	EXPECT_TRUE(floats(0.0));
+	EXPECT_FALSE(floats(-0.0));
+	EXPECT_FALSE(floats(std::nan("")));
+	EXPECT_TRUE(floats(1.0));
+	EXPECT_FALSE(floats(std::nan("")));
+	EXPECT_EQ(calls, 4u);
+
+	// exceptions are not remembered
+	memoized_validator<string_ini_t> throwing(
+		[](const string_ini_t &value) -> bool { throw validation_exception(value); }, 10);
+	EXPECT_THROW(throwing("a"), validation_exception);
+	EXPECT_THROW(throwing("a"), validation_exception);
+	EXPECT_EQ(throwing.statistics().size, 0u);
+}
+
+TEST(memoized_validator, shared_by_options)
+{
+	size_t calls = 0;
+	memoized_validator<signed_ini_t> validator(
+		[&calls](signed_ini_t value) {
+			++calls;
+			return value >= 0;
+		},
+		10);
+	section_schema_params sect_params;
+	sect_params.name = "sect";
+	section_schema sect_schema(sect_params);
+	option_schema_params<signed_ini_t> params;
+	params.name = "first";
+	params.validator = validator;
+	sect_schema.add_option(params);
+	params.name = "second";
+	sect_schema.add_option(params);
+	params.name = "other";
+	params.validator = memoized_validator<signed_ini_t>([](signed_ini_t) { return true; }, 10);
+	sect_schema.add_option(params);
+
+	option first("first", "1");
+	option second("second", "1");
+	option second_changed("second", "2");
+	option other("other", "1");
+	sect_schema["first"].validate_option(first);
+	sect_schema["second"].validate_option(second);
+	sect_schema["second"].validate_option(second_changed);
+	sect_schema["other"].validate_option(other);
+	EXPECT_EQ(calls, 2u);
+
+	// both options report the shared cache, section counts it once
+	EXPECT_EQ(sect_schema["first"].get_memo_statistics().hits, 1u);
+	EXPECT_EQ(sect_schema["second"].get_memo_statistics().misses, 2u);
+	memo_statistics statistics = sect_schema.get_memo_statistics();
+	EXPECT_EQ(statistics.hits, 1u);
+	EXPECT_EQ(statistics.misses, 3u);
+	EXPECT_EQ(statistics.size, 3u);
+	EXPECT_EQ(validator.statistics().size, 2u);
+
+	schema schm;
+	schm.add_section(sect_params);
+	params.name = "first";
+	params.validator = validator;
+	schm.add_option("sect", params);
+	params.name = "second";
+	schm.add_option("sect", params);
+	EXPECT_EQ(schm.get_memo_statistics().misses, 2u);
+}
+
+TEST(memoized_validator, schema_statistics)
+{
+	std::atomic<size_t> calls(0);
+	schema schm;
+	option_schema_params<string_ini_t> params;
+	params.name = "host";
+	params.validator = memoized_validator<string_ini_t>(
+		[&calls](const string_ini_t &value) {
+			++calls;
+			return value != "invalid";
+		},
+		100);
+	std::string str;
+	section_schema_params sect_params;
+	for (int i = 0; i < 50; ++i) {
+		sect_params.name = "section" + std::to_string(i);
+		schm.add_section(sect_params);
+		schm.add_option(sect_params.name, params);
+		str += "[" + sect_params.name + "]\nhost = host" + std::to_string(i % 5) + "\n";
+	}
+	EXPECT_EQ(schm.get_memo_statistics().misses, 0u);
+
+	// validator is shared by all sections and reloads of the config
+	config cfg = parser::load(str, schm, schema_mode::strict);
+	EXPECT_EQ(calls, 5u);
+	config reloaded = parser::load(str, schm, schema_mode::strict);
+	EXPECT_TRUE(cfg == reloaded);
+	EXPECT_EQ(calls, 5u);
+	memo_statistics statistics = schm["section0"]["host"].get_memo_statistics();
+	EXPECT_EQ(statistics.misses, 5u);
+	EXPECT_EQ(statistics.hits, 95u);
+
+	// every option schema holds copy of the validator, its cache is counted once
+	EXPECT_EQ(schm.get_memo_statistics().hits, 95u);
+	EXPECT_EQ(schm.get_memo_statistics().misses, 5u);
+	EXPECT_EQ(schm["section1"].get_memo_statistics().size, 5u);
+
+	// results do not depend on the cache and concurrent validation
+	std::vector<std::thread> threads;
+	std::vector<int> failures(4, 0);
+	for (size_t t = 0; t < 4; ++t) {
+		threads.emplace_back([&schm, &failures, t]() {
+			const schema &shared = schm;
+			for (int i = 0; i < 200; ++i) {
+				std::string host = (i + t) % 7 == 0 ? "invalid" : "host" + std::to_string(i % 150);
+				option opt("host", host);
+				try {
+					shared["section0"]["host"].validate_option(opt);
+				} catch (const validation_exception &) {
+					++failures[t];
+				}
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	for (size_t t = 0; t < 4; ++t) {
+		int expected = 0;
+		for (int i = 0; i < 200; ++i) {
+			expected += (i + t) % 7 == 0 ? 1 : 0;
+		}
+		EXPECT_EQ(failures[t], expected);
+	}
+	EXPECT_LE(schm["section0"]["host"].get_memo_statistics().size, 100u);
+}
@@ -0,0 +1,74 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "config.h"
+#include "name_index.h"
+
+
+using namespace inicpp;
+
+
+TEST(name_index, hash)
+{
+	EXPECT_EQ(name_index::hash("option"), name_index::hash(std::string("option")));
+	EXPECT_NE(name_index::hash("option"), name_index::hash("option2"));
+	EXPECT_NE(name_index::hash(""), name_index::hash(std::string_view("\0", 1)));
+	// names longer than one block differ only in the tail
+	EXPECT_NE(name_index::hash("long_option_name_1"), name_index::hash("long_option_name_2"));
+}
+
+TEST(name_index, insert_find_rebuild)
+{
+	std::vector<std::string> names;
+	auto name_of = [&](size_t position) -> const std::string & { return names[position]; };
+
+	name_index index;
+	EXPECT_EQ(index.find("missing", name_of), name_index::npos);
+
+	// enough names to grow the table several times
+	for (size_t i = 0; i < 1000; ++i) {
+		names.push_back("name" + std::to_string(i));
+		index.insert(name_index::hash(names.back()), name_of);
+	}
+	EXPECT_EQ(index.size(), 1000u);
+	for (size_t i = 0; i < names.size(); ++i) {
+		EXPECT_EQ(index.find(names[i], name_of), i);
+	}
+	EXPECT_EQ(index.find("name1000", name_of), name_index::npos);
+
+	names.erase(names.begin());
+	index.rebuild(names.size(), name_of);
+	EXPECT_EQ(index.size(), 999u);
+	EXPECT_EQ(index.find("name0", name_of), name_index::npos);
+	EXPECT_EQ(index.find("name1", name_of), 0u);
+	EXPECT_EQ(index.find("name999", name_of), 998u);
+
+	index.clear();
+	EXPECT_EQ(index.size(), 0u);
+	EXPECT_EQ(index.find("name1", name_of), name_index::npos);
+}
+
+TEST(name_index, many_keys)
+{
+	config cfg;
+	cfg.add_section("sect");
+	for (size_t i = 0; i < 20000; ++i) {
+		cfg.add_option<signed_ini_t>("sect", "opt" + std::to_string(i), i);
+	}
+	const section &sect = cfg["sect"];
+	EXPECT_EQ(sect.size(), 20000u);
+	for (size_t i = 0; i < 20000; i += 7) {
+		std::string name = "opt" + std::to_string(i);
+		EXPECT_TRUE(sect.contains(name));
+		EXPECT_EQ(sect[name].get<signed_ini_t>(), static_cast<signed_ini_t>(i));
+		EXPECT_EQ(sect[i].get_name(), name);
+	}
+	EXPECT_FALSE(sect.contains("opt20000"));
+	EXPECT_THROW(cfg.add_option<signed_ini_t>("sect", "opt5", 5), ambiguity_exception);
+
+	// removal keeps order and shifts positions of following options
+	cfg.remove_option("sect", "opt0");
+	EXPECT_EQ(cfg["sect"][0].get_name(), "opt1");
+	EXPECT_EQ(cfg["sect"]["opt19999"].get<signed_ini_t>(), 19999);
+	EXPECT_THROW(cfg["sect"]["opt0"], not_found_exception);
+}
@@ -3,22 +3,12 @@
 
 #include "option.h"
 #include "types.h"
+#include <thread>
 #include <vector>
 
 using namespace std::literals;
 using namespace inicpp;
 
-/**
- * Construct, get and set value to @ref option_value class.
- */
-TEST(option, option_value_helper_class)
-{
-	option_value<string_ini_t> value("testing string");
-	EXPECT_EQ(value.get(), "testing string");
-	value.set("another string");
-	EXPECT_EQ(value.get(), "another string");
-}
-
 /**
  * Create @ref option with single @ref string_t type and get some values.
  */
@@ -138,6 +128,137 @@ TEST(option, copying)
 	EXPECT_EQ(moved_assignment.get<string_ini_t>(), my_option.get<string_ini_t>());
 }
 
+TEST(option, conversion_cache)
+{
+	option my_option("name", "42");
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 42);
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 42);
+	// only the first conversion is remembered, others still work
+	EXPECT_EQ(my_option.get<unsigned_ini_t>(), 42u);
+	EXPECT_EQ(my_option.get<float_ini_t>(), 42.0);
+	EXPECT_THROW(my_option.get<boolean_ini_t>(), bad_cast_exception);
+	EXPECT_EQ(my_option.get<string_ini_t>(), "42");
+
+	// every modification forgets the cached value
+	my_option = "43";
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 43);
+	my_option.add_to_list<string_ini_t>("44", 0);
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 44);
+	my_option.remove_from_list_pos(0);
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 43);
+	my_option.set_list<string_ini_t>({"45", "46"});
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 45);
+	my_option.remove_from_list<string_ini_t>("45");
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 46);
+
+	// copies have their own cache
+	option other("other", "47");
+	EXPECT_EQ(other.get<signed_ini_t>(), 47);
+	other = my_option;
+	EXPECT_EQ(other.get<signed_ini_t>(), 46);
+	other = option("other", "48");
+	EXPECT_EQ(other.get<signed_ini_t>(), 48);
+
+	// failed conversion is not cached
+	option text("text", "abc");
+	EXPECT_THROW(text.get<signed_ini_t>(), bad_cast_exception);
+	EXPECT_EQ(text.get<enum_ini_t>(), enum_ini_t("abc"));
+
+	// concurrent readers fill the cache safely
+	const option shared("shared", "-12");
+	std::vector<std::thread> readers;
+	std::vector<int> failures(4, 0);
+	for (size_t i = 0; i < failures.size(); ++i) {
+		readers.emplace_back([&shared, &failures, i]() {
+			for (int j = 0; j < 1000; ++j) {
+				if (shared.get<signed_ini_t>() != -12) {
+					failures[i]++;
+				}
+			}
+		});
+	}
+	for (auto &reader : readers) {
+		reader.join();
+	}
+	EXPECT_EQ(failures, std::vector<int>(4, 0));
+}
+
+/**
+ * Values are stored in typed list, conversions and type checks work on it.
+ */
+TEST(option, typed_value_storage)
+{
+	option my_option("name");
+	my_option.set_list<signed_ini_t>({1, -2, 3});
+	EXPECT_EQ(my_option.get_type(), option_type::signed_e);
+	EXPECT_EQ(my_option.get_list<signed_ini_t>(), std::vector<signed_ini_t>({1, -2, 3}));
+	EXPECT_EQ(my_option.get_list<float_ini_t>(), std::vector<float_ini_t>({1.0, -2.0, 3.0}));
+	EXPECT_EQ(my_option.get_list<string_ini_t>(), std::vector<string_ini_t>({"1", "-2", "3"}));
+
+	// only values of option type can be added or removed
+	EXPECT_THROW(my_option.add_to_list<unsigned_ini_t>(4), bad_cast_exception);
+	EXPECT_THROW(my_option.add_to_list("4"), bad_cast_exception);
+	EXPECT_THROW(my_option.remove_from_list<string_ini_t>("1"), bad_cast_exception);
+	my_option.add_to_list<signed_ini_t>(4, 1);
+	my_option.remove_from_list<signed_ini_t>(-2);
+	my_option.remove_from_list<signed_ini_t>(100);
+	EXPECT_EQ(my_option.get_list<signed_ini_t>(), std::vector<signed_ini_t>({1, 4, 3}));
+
+	// copy has its own values
+	option copy(my_option);
+	copy.remove_from_list_pos(0);
+	EXPECT_EQ(copy.get<signed_ini_t>(), 4);
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 1);
+
+	// the same values of different types are not equal
+	option first("name");
+	option second("name");
+	first.set<signed_ini_t>(5);
+	second.set<unsigned_ini_t>(5u);
+	EXPECT_NE(first, second);
+	second.set<signed_ini_t>(5);
+	EXPECT_EQ(first, second);
+
+	// setting single value changes type and drops the list
+	my_option = true;
+	EXPECT_EQ(my_option.get_type(), option_type::boolean_e);
+	EXPECT_FALSE(my_option.is_list());
+	EXPECT_TRUE(my_option.get<boolean_ini_t>());
+}
+
+/**
+ * Read-only accessors refer to stored values instead of copying them.
+ */
+TEST(option, value_views)
+{
+	option my_option("name", "some text");
+	const std::string &text = my_option.get_ref<string_ini_t>();
+	EXPECT_EQ(text, "some text");
+	EXPECT_EQ(&text, &my_option.get_ref<string_ini_t>());
+	EXPECT_EQ(my_option.get_string_view(), "some text");
+	EXPECT_EQ(my_option.get_string_view().data(), text.data());
+
+	my_option.set_list<signed_ini_t>({1, -2, 3});
+	value_view<signed_ini_t> values = my_option.get_view<signed_ini_t>();
+	EXPECT_EQ(values.size(), 3u);
+	EXPECT_EQ(std::vector<signed_ini_t>(values.begin(), values.end()), std::vector<signed_ini_t>({1, -2, 3}));
+	EXPECT_EQ(values[1], -2);
+	EXPECT_EQ(&values.front(), &my_option.get_ref<signed_ini_t>());
+
+	// values are never converted
+	EXPECT_THROW(my_option.get_view<unsigned_ini_t>(), bad_cast_exception);
+	EXPECT_THROW(my_option.get_ref<string_ini_t>(), bad_cast_exception);
+	EXPECT_THROW(my_option.get_string_view(), bad_cast_exception);
+	EXPECT_THROW(my_option.get_view<int>(), bad_cast_exception);
+
+	// empty list
+	my_option.remove_from_list_pos(0);
+	my_option.remove_from_list_pos(0);
+	my_option.remove_from_list_pos(0);
+	EXPECT_THROW(my_option.get_view<signed_ini_t>(), not_found_exception);
+	EXPECT_THROW(my_option.get_ref<signed_ini_t>(), not_found_exception);
+}
+
 /**
  * Test format of output stream.
  */
@@ -0,0 +1,90 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "config.h"
+#include "option_handle.h"
+#include "parser.h"
+
+using namespace inicpp;
+
+
+TEST(option_handle, access_and_remapping)
+{
+	config cfg;
+	cfg.add_section("sect");
+	cfg.add_option<signed_ini_t>("sect", "first", 1);
+	cfg.add_option<signed_ini_t>("sect", "second", 2);
+
+	option_handle handle(cfg, "sect", "second");
+	EXPECT_EQ(handle.get_section_name(), "sect");
+	EXPECT_EQ(handle.get_option_name(), "second");
+	EXPECT_EQ(handle.get(cfg).get<signed_ini_t>(), 2);
+
+	// modification through handle
+	handle.get(cfg).set<signed_ini_t>(3);
+	EXPECT_EQ(cfg["sect"]["second"].get<signed_ini_t>(), 3);
+
+	// layout of section changes, option moves to another position
+	cfg.remove_option("sect", "first");
+	EXPECT_EQ(handle.get(cfg).get<signed_ini_t>(), 3);
+	cfg["sect"].add_option<signed_ini_t>("zeroth", 0);
+	EXPECT_EQ(handle.get(cfg).get<signed_ini_t>(), 3);
+
+	// layout of config changes, section moves to another position
+	cfg.add_section("before");
+	cfg.add_section("after");
+	cfg.remove_section("before");
+	config reordered;
+	reordered.add_section("other");
+	reordered.add_section(cfg["sect"]);
+	EXPECT_EQ(handle.get(reordered).get<signed_ini_t>(), 3);
+	EXPECT_EQ(handle.get(cfg).get<signed_ini_t>(), 3);
+
+	// copy has the same layout, but accesses its own options
+	config copy(cfg);
+	copy["sect"]["second"].set<signed_ini_t>(4);
+	EXPECT_EQ(handle.get(copy).get<signed_ini_t>(), 4);
+	EXPECT_EQ(handle.get(cfg).get<signed_ini_t>(), 3);
+
+	// option disappears
+	cfg.remove_option("sect", "second");
+	EXPECT_THROW(handle.get(cfg), not_found_exception);
+	cfg.add_option<signed_ini_t>("sect", "second", 5);
+	EXPECT_EQ(handle.get(cfg).get<signed_ini_t>(), 5);
+
+	// unmapped handle and nonexisting names
+	option_handle unmapped("sect", "zeroth");
+	EXPECT_EQ(unmapped.get(static_cast<const config &>(cfg)).get<signed_ini_t>(), 0);
+	EXPECT_THROW(option_handle(cfg, "missing", "second"), not_found_exception);
+	EXPECT_THROW(option_handle(cfg, "sect", "missing"), not_found_exception);
+}
+
+TEST(option_handle, file_reload)
+{
+	{
+		std::ofstream file("option_handle_test.ini");
+		file << "[server]\n"
+				"host = localhost\n"
+				"port = 8080\n";
+	}
+	config cfg = parser::load_file("option_handle_test.ini");
+	option_handle port(cfg, "server", "port");
+	EXPECT_EQ(port.get(cfg).get<signed_ini_t>(), 8080);
+
+	// another section in front and options in different order
+	{
+		std::ofstream file("option_handle_test.ini");
+		file << "[client]\n"
+				"timeout = 5\n"
+				"[server]\n"
+				"port = 9090\n"
+				"host = example.com\n";
+	}
+	cfg = parser::load_file("option_handle_test.ini");
+	EXPECT_EQ(port.get(cfg).get<signed_ini_t>(), 9090);
+
+	std::remove("option_handle_test.ini");
+}
@@ -0,0 +1,66 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "config.h"
+#include "option_key.h"
+
+using namespace inicpp;
+
+
+TEST(option_key, literal_keys)
+{
+	config cfg;
+	cfg.add_section("Numbers");
+	cfg.add_option<signed_ini_t>("Numbers", "num", -1285);
+	cfg.add_option<string_ini_t>("Numbers", "text", "42");
+
+	// keys are used outside of EXPECT_EQ, which puts its argument into unevaluated context
+	signed_ini_t num = cfg.get<signed_ini_t>(INICPP_KEY("Numbers", "num"));
+	EXPECT_EQ(num, -1285);
+	// conversion from string option
+	unsigned_ini_t text = cfg.get<unsigned_ini_t>(INICPP_KEY("Numbers", "text"));
+	EXPECT_EQ(text, 42u);
+	const option &text_option = cfg.get_option(INICPP_KEY("Numbers", "text"));
+	EXPECT_EQ(text_option.get_name(), "text");
+
+	// the same call site used repeatedly reuses its key
+	const option_key *first = nullptr;
+	for (int i = 0; i < 3; ++i) {
+		const option_key &key = INICPP_KEY("Numbers", "num");
+		if (first == nullptr) {
+			first = &key;
+		}
+		EXPECT_EQ(first, &key);
+		EXPECT_EQ(key.section_hash(), name_index::hash("Numbers"));
+		EXPECT_EQ(key.option_hash(), name_index::hash("num"));
+	}
+
+	// names with the same prefix
+	EXPECT_THROW(cfg.get<signed_ini_t>(INICPP_KEY("Numbers", "nu")), not_found_exception);
+	EXPECT_THROW(cfg.get<signed_ini_t>(INICPP_KEY("Numbers", "numb")), not_found_exception);
+	EXPECT_THROW(cfg.get<signed_ini_t>(INICPP_KEY("Number", "num")), not_found_exception);
+
+	// modification through key
+	cfg.get_option(INICPP_KEY("Numbers", "num")).set<signed_ini_t>(7);
+	EXPECT_EQ(cfg["Numbers"]["num"].get<signed_ini_t>(), 7);
+}
+
+TEST(option_key, runtime_keys)
+{
+	config cfg;
+	cfg.add_section("sect");
+	cfg.add_option<float_ini_t>("sect", "opt", 2.5);
+
+	std::string section_name = "sect";
+	std::string option_name = "opt";
+	option_key key(section_name, option_name);
+	EXPECT_EQ(key.section_name(), "sect");
+	EXPECT_EQ(key.option_name(), "opt");
+	EXPECT_DOUBLE_EQ(cfg.get<float_ini_t>(key), 2.5);
+
+	// copy keeps computed hashes
+	option_key copy(key);
+	EXPECT_DOUBLE_EQ(cfg.get<float_ini_t>(copy), 2.5);
+	const config &const_cfg = cfg;
+	EXPECT_EQ(const_cfg.get_option(copy).get_name(), "opt");
+}
@@ -149,6 +149,81 @@ TEST(option_schema, validation)
 	EXPECT_NO_THROW(float_schema.validate_option(float_option));
 	std::vector<float_ini_t> float_values{4.5, -6.3, 0.0};
 	EXPECT_EQ(float_option.get_list<float_ini_t>(), float_values);
+
+	// values of other types than string are converted
+	option typed_option("name");
+	typed_option.set<signed_ini_t>(3);
+	float_params.type = option_item::single;
+	option_schema single_float_schema(float_params);
+	EXPECT_NO_THROW(single_float_schema.validate_option(typed_option));
+	EXPECT_EQ(typed_option.get_type(), option_type::float_e);
+	EXPECT_DOUBLE_EQ(typed_option.get<float_ini_t>(), 3.0);
+
+	option_schema_params<string_ini_t> string_params;
+	string_params.name = "name";
+	string_params.validator = [](string_ini_t str) { return str == "3"; };
+	option_schema string_schema(string_params);
+	typed_option.set<signed_ini_t>(3);
+	EXPECT_NO_THROW(string_schema.validate_option(typed_option));
+	typed_option.set<signed_ini_t>(4);
+	EXPECT_THROW(string_schema.validate_option(typed_option), validation_exception);
+}
+
+TEST(option_schema, parsing_options)
+{
+	option_schema_params<unsigned_ini_t> unsigned_params;
+	unsigned_params.name = "name";
+	unsigned_params.type = option_item::list;
+	option_schema unsigned_schema(unsigned_params);
+
+	// escaped values are parsed straight into the type of the schema
+	std::vector<std::string_view> values{"1", "2", "3"};
+	option opt = unsigned_schema.parse_option("name", values, {});
+	EXPECT_EQ(opt.get_name(), "name");
+	EXPECT_EQ(opt.get_type(), option_type::unsigned_e);
+	EXPECT_EQ(opt.get_list<unsigned_ini_t>(), std::vector<unsigned_ini_t>({1, 2, 3}));
+	EXPECT_NO_THROW(unsigned_schema.validate_option(opt));
+	values.push_back("text");
+	EXPECT_THROW(unsigned_schema.parse_option("name", values, {}), invalid_type_exception);
+
+	option_schema_params<string_ini_t> string_params;
+	string_params.name = "name";
+	option_schema string_schema(string_params);
+	std::vector<std::string_view> escaped{"a\\,b"};
+	option unescaped = string_schema.parse_option("name", escaped, {});
+	EXPECT_EQ(unescaped.get<string_ini_t>(), "a,b");
+}
+
+TEST(option_schema, constraints)
+{
+	option_schema_params<unsigned_ini_t> params;
+	params.name = "name";
+	params.type = option_item::list;
+	params.constraints.range(1, 10).ordered(list_order::strictly_ascending);
+	params.validator = [](unsigned_ini_t i) { return i != 5; };
+	option_schema schm(params);
+
+	option opt("name", std::vector<std::string>{"1", "2", "3"});
+	EXPECT_NO_THROW(schm.validate_option(opt));
+	std::vector<std::vector<std::string>> invalid = {{"1", "20"}, {"2", "1"}, {"4", "5"}};
+	for (auto &values : invalid) {
+		option invalid_opt("name", values);
+		EXPECT_THROW(schm.validate_option(invalid_opt), validation_exception);
+		// bound validator checks the same constraints
+		option bound_opt("name", values);
+		EXPECT_THROW(schm.bind_validator()(bound_opt), validation_exception);
+	}
+
+	// string schema checks converted values of other types
+	option_schema_params<string_ini_t> string_params;
+	string_params.name = "name";
+	string_params.constraints.length(1, 2);
+	option_schema string_schema(string_params);
+	option typed_opt("name");
+	typed_opt.set<signed_ini_t>(42);
+	EXPECT_NO_THROW(string_schema.validate_option(typed_opt));
+	typed_opt.set<signed_ini_t>(420);
+	EXPECT_THROW(string_schema.validate_option(typed_opt), validation_exception);
 }
 
 TEST(option_schema, writing_to_ostream)
@@ -171,4 +246,17 @@ TEST(option_schema, writing_to_ostream)
 								  ";<default value: \"default_value\">\n"
 								  "name = default_value\n";
 	EXPECT_EQ(str.str(), expected_output);
+
+	// constraints are written after default value
+	params.constraints.range(0, 100).unique();
+	option_schema constrained_option(params);
+	str.str("");
+	str << constrained_option;
+	expected_output = ";comment\n"
+					  ";multiline\n"
+					  ";<optional, list>\n"
+					  ";<default value: \"default_value\">\n"
+					  ";<constraints: range [0, 100], unique>\n"
+					  "name = default_value\n";
+	EXPECT_EQ(str.str(), expected_output);
 }
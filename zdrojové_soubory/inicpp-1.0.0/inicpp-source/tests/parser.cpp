@@ -1,6 +1,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
+
 #include "parser.h"
 
 using namespace inicpp;
@@ -133,6 +136,57 @@ TEST(parser, store_config)
 }
 
 
+TEST(parser, store_and_load_special_characters)
+{
+	config my_config;
+	my_config.add_section("section");
+	my_config.add_option("section", "path", std::string("C:\\dir\\file;1"));
+	my_config.add_option("section", "url", std::string("http://example.com"));
+	my_config.add_option("section", "spaces", std::string(" padded "));
+	option list_option("list");
+	list_option.set_list<string_ini_t>({"a,b", "c:d"});
+	my_config.add_option("section", list_option);
+
+	std::ostringstream str;
+	parser::save(my_config, str);
+	auto loaded_config = parser::load(str.str());
+
+	EXPECT_EQ(loaded_config["section"]["path"].get<string_ini_t>(), "C:\\dir\\file;1");
+	EXPECT_EQ(loaded_config["section"]["url"].get<string_ini_t>(), "http://example.com");
+	EXPECT_EQ(loaded_config["section"]["spaces"].get<string_ini_t>(), " padded ");
+	std::vector<std::string> expected_list{"a,b", "c:d"};
+	EXPECT_EQ(loaded_config["section"]["list"].get_list<string_ini_t>(), expected_list);
+}
+
+TEST(parser, option_lists)
+{
+	std::string str_config = ""
+							 "[section]\n"
+							 "commas = a , b\\,c ,\\ d\\ , e:f\n"
+							 "colons = a: b :c\n"
+							 "escaped = x\\\\, y\\ \n";
+	auto loaded_config = parser::load(str_config);
+
+	std::vector<std::string> expected{"a", "b,c", " d ", "e:f"};
+	EXPECT_EQ(loaded_config["section"]["commas"].get_list<string_ini_t>(), expected);
+	expected = {"a", "b", "c"};
+	EXPECT_EQ(loaded_config["section"]["colons"].get_list<string_ini_t>(), expected);
+	expected = {"x\\", "y "};
+	EXPECT_EQ(loaded_config["section"]["escaped"].get_list<string_ini_t>(), expected);
+
+	// huge list on one line
+	const size_t count = 50000;
+	str_config = "[section]\nhuge = 0";
+	for (size_t i = 1; i < count; ++i) {
+		str_config += ", " + std::to_string(i);
+	}
+	loaded_config = parser::load(str_config);
+	auto huge_list = loaded_config["section"]["huge"].get_list<string_ini_t>();
+	ASSERT_EQ(huge_list.size(), count);
+	EXPECT_EQ(huge_list[0], "0");
+	EXPECT_EQ(huge_list[count - 1], std::to_string(count - 1));
+}
+
 TEST(parser, including_others)
 {
 	/*
@@ -179,3 +233,340 @@ TEST(parser, including_others)
 
 	// Testing schema validation again is not necessary.
 }
+
+namespace
+{
+	/** Handler which records received events and does not fail on errors. */
+	class recording_handler : public parse_handler
+	{
+	public:
+		std::vector<std::string> sections;
+		std::vector<std::string> options;
+		std::vector<std::string> comments;
+		std::vector<std::string> includes;
+		std::vector<size_t> error_lines;
+
+		virtual void on_section(std::string_view name, size_t)
+		{
+			sections.emplace_back(name);
+		}
+
+		virtual void on_option(std::string_view name, const std::vector<std::string_view> &values, size_t)
+		{
+			std::string joined(name);
+			for (auto value : values) {
+				joined += "|" + std::string(value);
+			}
+			options.push_back(joined);
+		}
+
+		virtual void on_comment(std::string_view comment, size_t)
+		{
+			comments.emplace_back(comment);
+		}
+
+		virtual void on_include(std::string_view resource_name)
+		{
+			includes.emplace_back(resource_name);
+		}
+
+		virtual void on_error(const std::string &, size_t line_number)
+		{
+			error_lines.push_back(line_number);
+		}
+	};
+}
+
+TEST(parser, parse_events)
+{
+	std::string str = "; leading comment\n"
+					  "opt_before = 1\n"
+					  "[section] ; trailing comment\n"
+					  "opt = a, b\\,c , d\\ \n"
+					  "wrong line\n"
+					  "[bad section name\n"
+					  "[section2]\n"
+					  "link = ${section#opt}\n";
+
+	recording_handler handler;
+	parser::parse(str, handler);
+	std::vector<std::string> expected_sections{"section", "section2"};
+	EXPECT_EQ(handler.sections, expected_sections);
+	// values are reported trimmed, but still escaped
+	std::vector<std::string> expected_options{"opt|a|b\\,c|d\\ ", "link|${section#opt}"};
+	EXPECT_EQ(handler.options, expected_options);
+	std::vector<std::string> expected_comments{" leading comment", " trailing comment"};
+	EXPECT_EQ(handler.comments, expected_comments);
+	std::vector<size_t> expected_errors{2, 5, 6};
+	EXPECT_EQ(handler.error_lines, expected_errors);
+
+	// default handler throws on the first error
+	parse_handler strict_handler;
+	EXPECT_THROW(parser::parse(str, strict_handler), parser_exception);
+	EXPECT_NO_THROW(parser::parse(std::string("[section]\nopt = val ; comment"), strict_handler));
+
+	// included resources are reported
+	stream_resource_stack<std::stringstream, std::string> inputs("config.ini",
+		{{"config.ini", "[section]\n#include inner.ini\n#include inner.ini"}, {"inner.ini", "opt = val"}});
+	recording_handler include_handler;
+	parser::parse(inputs, include_handler);
+	std::vector<std::string> expected_includes{"inner.ini", "inner.ini"};
+	EXPECT_EQ(include_handler.includes, expected_includes);
+	EXPECT_EQ(include_handler.options.size(), 2u);
+	EXPECT_TRUE(include_handler.error_lines.empty());
+}
+
+TEST(parser, links)
+{
+	std::string str = "[first]\n"
+					  "forward = ${second#value}\n"
+					  "own_forward = ${first#plain}, ${second#chained}\n"
+					  "plain = text, ignored\n"
+					  "[second]\n"
+					  "chained = ${first#forward}\n"
+					  "value = ${first#plain}\n";
+
+	auto loaded_config = parser::load(str);
+	EXPECT_EQ(loaded_config["first"]["forward"].get<string_ini_t>(), "text");
+	std::vector<std::string> expected_list{"text", "text"};
+	EXPECT_EQ(loaded_config["first"]["own_forward"].get_list<string_ini_t>(), expected_list);
+	EXPECT_EQ(loaded_config["second"]["chained"].get<string_ini_t>(), "text");
+	EXPECT_EQ(loaded_config["second"]["value"].get<string_ini_t>(), "text");
+
+	// cycles and missing targets are reported with line of the link
+	try {
+		parser::load("[a]\nx = ${b#y}\n[b]\ny = ${a#z}\n[a2]\nz = ${a#x}\n[a]");
+		FAIL();
+	} catch (ambiguity_exception &) {
+	}
+	try {
+		parser::load("[a]\nx = ${b#y}\nz = ${a#x}\n[b]\ny = ${a#z}");
+		FAIL();
+	} catch (parser_exception &e) {
+		EXPECT_STREQ(e.what(), "Cyclic link on line 3");
+	}
+	try {
+		parser::load("[a]\nx = ${a#x}");
+		FAIL();
+	} catch (parser_exception &e) {
+		EXPECT_STREQ(e.what(), "Cyclic link on line 2");
+	}
+	try {
+		parser::load("[a]\nx = val\ny = ${c#x}");
+		FAIL();
+	} catch (parser_exception &e) {
+		EXPECT_STREQ(e.what(), "Bad link on line 3");
+	}
+	EXPECT_THROW(parser::load("[a]\nx = ${a#}"), parser_exception);
+	EXPECT_THROW(parser::load("[a]\nx = ${#x}"), parser_exception);
+
+	// many options refer to the same target
+	std::string fan_out = "[target]\nvalue = shared\n[links]\n";
+	for (int i = 0; i < 1000; ++i) {
+		fan_out += "link" + std::to_string(i) + " = ${target#value}, ${links#link0}\n";
+	}
+	auto fan_config = parser::load(fan_out);
+	std::vector<std::string> expected_fan{"shared", "shared"};
+	EXPECT_EQ(fan_config["links"]["link999"].get_list<string_ini_t>(), expected_fan);
+}
+
+TEST(parser, parallel_load)
+{
+	/*
+	 * Config has to be large enough to be split into several chunks,
+	 * links go to previous sections (possibly in other chunks) and to options
+	 * of the current section which are links to other sections themselves.
+	 */
+	std::string str = "; header comment\n";
+	for (int i = 0; i < 5000; ++i) {
+		std::string name = "section" + std::to_string(i);
+		str += "[" + name + "]\n";
+		str += "first = " + (i > 0 ? "${section" + std::to_string(i / 2) + "#second}" : std::string("start")) + "\n";
+		str += "second = ${" + name + "#first}, value" + std::to_string(i) + "\n";
+		str += "third = a\\, b, c : d ; comment\n";
+		str += "\n";
+	}
+
+	parser_options parallel;
+	parallel.threads = 8;
+	auto serial_config = parser::load(str);
+	auto parallel_config = parser::load(str, parallel);
+	EXPECT_EQ(parallel_config.size(), 5000u);
+	EXPECT_TRUE(serial_config == parallel_config);
+	EXPECT_EQ(parallel_config["section4999"]["first"].get<string_ini_t>(), "start");
+	EXPECT_EQ(parallel_config["section4999"]["second"].get<string_ini_t>(), "start");
+
+	// errors are reported in the same order as by serial loading
+	std::string broken = str + "[section10]\nopt = val\n[section5000]\nlink = ${section4999#missing}";
+	EXPECT_THROW(parser::load(broken, parallel), ambiguity_exception);
+	broken = str + "[section5000]\nlink = ${section5001#first}\n[section5001]\nfirst = ${section0#missing}";
+	try {
+		parser::load(broken, parallel);
+		FAIL();
+	} catch (parser_exception &e) {
+		EXPECT_STREQ(e.what(), "Option name in link not found on line 25005");
+	}
+
+	// files without includes are loaded in parallel, others fall back to one thread
+	{
+		std::ofstream main_file("parser_test_parallel.ini");
+		main_file << str;
+	}
+	EXPECT_TRUE(parser::load_file("parser_test_parallel.ini", parallel) == serial_config);
+	{
+		std::ofstream main_file("parser_test_parallel.ini", std::ios::app);
+		main_file << "#include parser_test_parallel_included.ini\n";
+		std::ofstream included_file("parser_test_parallel_included.ini");
+		included_file << "included = val\n";
+	}
+	auto included_config = parser::load_file("parser_test_parallel.ini", parallel);
+	EXPECT_EQ(included_config["section4999"]["included"].get<string_ini_t>(), "val");
+	std::remove("parser_test_parallel.ini");
+	std::remove("parser_test_parallel_included.ini");
+}
+
+TEST(parser, memory_resource)
+{
+	std::string str;
+	for (int i = 0; i < 2000; ++i) {
+		str += "[section" + std::to_string(i) + "]\n";
+		str += "list = a, b, c, d, e, f, g, h, i, j\n";
+		str += "link = ${section0#list}\n";
+	}
+
+	// whole loaded tree is allocated from given resource
+	std::pmr::synchronized_pool_resource memory;
+	parser_options options;
+	options.memory = &memory;
+	config expected = parser::load(str);
+	config cfg = parser::load(str, options);
+	EXPECT_TRUE(cfg == expected);
+	EXPECT_EQ(cfg.get_allocator().resource(), &memory);
+	EXPECT_EQ(cfg["section1999"].get_allocator().resource(), &memory);
+	EXPECT_EQ(cfg["section1999"]["link"].get_allocator().resource(), &memory);
+
+	// the same resource is shared by all loading threads
+	options.threads = 4;
+	config parallel = parser::load(str, options);
+	EXPECT_TRUE(parallel == expected);
+	EXPECT_EQ(parallel["section1999"]["list"].get_allocator().resource(), &memory);
+}
+
+TEST(parser, schema_typed_loading)
+{
+	schema schm;
+	section_schema_params sect_params;
+	sect_params.name = "section";
+	schm.add_section(sect_params);
+	option_schema_params<signed_ini_t> number_params;
+	number_params.name = "number";
+	number_params.validator = [](signed_ini_t value) { return value < 100; };
+	schm.add_option("section", number_params);
+	option_schema_params<float_ini_t> list_params;
+	list_params.name = "list";
+	list_params.type = option_item::list;
+	schm.add_option("section", list_params);
+
+	// values are typed during loading, result is the same as validation of loaded strings
+	std::string str = "[section]\nnumber = 42\nlist = 1.5, 2.5\n[other]\nnumber = 7\n";
+	config expected = parser::load(str);
+	expected.validate(schm, schema_mode::relaxed);
+	config cfg = parser::load(str, schm, schema_mode::relaxed);
+	EXPECT_TRUE(cfg == expected);
+	EXPECT_EQ(cfg["section"]["number"].get_ref<signed_ini_t>(), 42);
+	EXPECT_EQ(cfg["section"]["list"].get_list<float_ini_t>(), std::vector<float_ini_t>({1.5, 2.5}));
+	EXPECT_EQ(cfg["other"]["number"].get_type(), option_type::string_e);
+
+	// errors are reported like by validation after loading
+	std::vector<std::string> invalid = {
+		"[section]\nnumber = text\nlist = 1, 2\n",         // value of wrong type
+		"[section]\nnumber = 142\nlist = 1, 2\n",          // validator fails
+		"[section]\nnumber = 1, 2\nlist = 1, 2\n",         // list instead of single value
+		"[section]\nnumber = text\nlist = 1, 2\nwrong\n", // parser error comes first
+	};
+	for (auto &invalid_str : invalid) {
+		std::string expected_message;
+		try {
+			config loaded = parser::load(invalid_str);
+			loaded.validate(schm, schema_mode::strict);
+		} catch (const exception &e) {
+			expected_message = e.what();
+		}
+		EXPECT_FALSE(expected_message.empty());
+		try {
+			parser::load(invalid_str, schm, schema_mode::strict);
+			ADD_FAILURE() << "invalid config was loaded";
+		} catch (const exception &e) {
+			EXPECT_EQ(e.what(), expected_message);
+		}
+	}
+
+	// links are resolved on the text of their targets, so values are typed after loading
+	option_schema_params<string_ini_t> text_params;
+	text_params.name = "text";
+	text_params.requirement = item_requirement::optional;
+	schm.add_option("section", text_params);
+	config linked = parser::load(
+		"[section]\nnumber = 042\nlist = ${section#number}, 1\ntext = ${section#number}\n", schm, schema_mode::strict);
+	EXPECT_EQ(linked["section"]["list"].get_list<float_ini_t>(), std::vector<float_ini_t>({42.0, 1.0}));
+	EXPECT_EQ(linked["section"]["text"].get<string_ini_t>(), "042");
+
+	// parallel loading types values of every chunk
+	schema numbers;
+	option_schema_params<unsigned_ini_t> unsigned_params;
+	unsigned_params.name = "number";
+	sect_params.requirement = item_requirement::optional;
+	std::string big;
+	for (int i = 0; i < 4000; ++i) {
+		big += "[section" + std::to_string(i) + "]\nnumber = " + std::to_string(i % 100) + "\n";
+		if (i % 3 == 0) {
+			sect_params.name = "section" + std::to_string(i);
+			numbers.add_section(sect_params);
+			numbers.add_option(sect_params.name, unsigned_params);
+		}
+	}
+	parser_options options;
+	options.threads = 4;
+	config serial = parser::load(big);
+	serial.validate(numbers, schema_mode::relaxed);
+	config parallel = parser::load(big, numbers, schema_mode::relaxed, options);
+	EXPECT_TRUE(parallel == serial);
+	EXPECT_EQ(parallel["section3999"]["number"].get_ref<unsigned_ini_t>(), 99u);
+	EXPECT_EQ(parallel["section3998"]["number"].get_type(), option_type::string_e);
+}
+
+TEST(parser, load_file_with_includes)
+{
+	/*
+	 * Files are loaded through mapped_file, so check line splitting on real
+	 * files including the last line without newline, an empty line
+	 * and an included file which is mapped separately.
+	 */
+	{
+		std::ofstream main_file("parser_test_main.ini");
+		main_file << "[section]\n"
+					 "opt = val\n"
+					 "\n"
+					 "#include parser_test_included.ini\n"
+					 "[section2::a]\n"
+					 "link = ${section#opt}";
+		std::ofstream included_file("parser_test_included.ini");
+		included_file << "opt2 = val2, val3, val4\n";
+		std::ofstream empty_file("parser_test_empty.ini");
+	}
+
+	auto loaded_config = parser::load_file("parser_test_main.ini");
+	EXPECT_EQ(loaded_config.size(), 2u);
+	EXPECT_EQ(loaded_config[0].size(), 2u);
+	EXPECT_EQ(loaded_config[0][0].get<string_ini_t>(), "val");
+	std::vector<std::string> expected_list{"val2", "val3", "val4"};
+	EXPECT_EQ(loaded_config[0][1].get_list<string_ini_t>(), expected_list);
+	EXPECT_EQ(loaded_config[1].get_name(), "section2::a");
+	EXPECT_EQ(loaded_config[1][0].get<string_ini_t>(), "val");
+
+	EXPECT_EQ(parser::load_file("parser_test_empty.ini").size(), 0u);
+
+	std::remove("parser_test_main.ini");
+	std::remove("parser_test_included.ini");
+	std::remove("parser_test_empty.ini");
+}
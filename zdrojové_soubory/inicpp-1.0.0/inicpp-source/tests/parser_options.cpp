@@ -0,0 +1,44 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "parser.h"
+#include "parser_options.h"
+
+
+using namespace inicpp;
+
+
+TEST(parser_options, standard_identifier_grammar)
+{
+	// validated at compile time
+	static_assert(identifier_grammar::standard().is_valid("section2::a"), "");
+	static_assert(!identifier_grammar::standard().is_valid("2section"), "");
+
+	identifier_grammar grammar = identifier_grammar::standard();
+	EXPECT_TRUE(grammar.is_valid("section"));
+	EXPECT_TRUE(grammar.is_valid(".$:"));
+	EXPECT_TRUE(grammar.is_valid("a-zA-Z0-9_~.:$ "));
+	EXPECT_FALSE(grammar.is_valid(""));
+	EXPECT_FALSE(grammar.is_valid("-section"));
+	EXPECT_FALSE(grammar.is_valid("_section"));
+	EXPECT_FALSE(grammar.is_valid("sect#ion"));
+	EXPECT_FALSE(grammar.is_valid("sect\xc3\xa9ion"));
+}
+
+TEST(parser_options, custom_identifier_grammar)
+{
+	identifier_grammar grammar("a-z", "a-z0-9-");
+	EXPECT_TRUE(grammar.is_valid("abc-123"));
+	EXPECT_FALSE(grammar.is_valid("Abc"));
+	EXPECT_FALSE(grammar.is_valid("abc_123"));
+
+	std::string str_config = ""
+							 "[_section]\n"
+							 "_opt = val\n";
+	EXPECT_THROW(parser::load(str_config), parser_exception);
+
+	parser_options options;
+	options.identifiers = identifier_grammar("_a-z", "_a-z");
+	auto loaded_config = parser::load(str_config, options);
+	EXPECT_EQ(loaded_config["_section"]["_opt"].get<string_ini_t>(), "val");
+}
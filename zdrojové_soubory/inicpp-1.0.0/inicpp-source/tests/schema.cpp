@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 
 #include "option_schema.h"
+#include "parser.h"
 #include "schema.h"
 #include "section_schema.h"
 
@@ -36,6 +37,38 @@ TEST(schema, creation_and_assignments)
 	EXPECT_TRUE(move_assigned.contains("name"));
 }
 
+TEST(schema, memory_resources)
+{
+	std::pmr::monotonic_buffer_resource memory;
+	schema schm((schema::allocator_type(&memory)));
+	section_schema_params sect_params;
+	sect_params.name = "name";
+	schm.add_section(sect_params);
+	sect_params.name = "other";
+	schm.add_section(section_schema(sect_params));
+	option_schema_params<signed_ini_t> opt_params;
+	opt_params.name = "number";
+	schm.add_option("name", opt_params);
+
+	// section schemas are created with resource of the schema
+	EXPECT_EQ(schm.get_allocator().resource(), &memory);
+	EXPECT_EQ(schm["name"].get_allocator().resource(), &memory);
+	EXPECT_EQ(schm["other"].get_allocator().resource(), &memory);
+
+	// copies use default resource unless other is given
+	schema copy(schm);
+	EXPECT_EQ(copy["name"].get_allocator().resource(), std::pmr::get_default_resource());
+	EXPECT_TRUE(copy["name"].contains("number"));
+	schema other_copy(schm, schema::allocator_type(&memory));
+	EXPECT_EQ(other_copy["other"].get_allocator().resource(), &memory);
+
+	// assignment keeps resource of the target
+	copy = std::move(other_copy);
+	EXPECT_EQ(copy["other"].get_allocator().resource(), std::pmr::get_default_resource());
+	EXPECT_EQ(copy.size(), 2u);
+	EXPECT_TRUE(copy["name"].contains("number"));
+}
+
 TEST(schema, adding_and_querying_sections)
 {
 	// create testing section in schema
@@ -82,6 +115,47 @@ TEST(schema, adding_and_querying_options)
 	EXPECT_THROW(schm.add_option("random", opt1_params), not_found_exception);
 }
 
+TEST(schema, string_view_lookup)
+{
+	schema schm;
+	section_schema_params sect_params;
+	sect_params.name = "name";
+	schm.add_section(sect_params);
+	option_schema_params<string_ini_t> opt_params;
+	opt_params.name = "opt1";
+	schm.add_option("name", opt_params);
+
+	std::string buffer = "nameopt1random";
+	std::string_view sect_name = std::string_view(buffer).substr(0, 4);
+	std::string_view opt_name = std::string_view(buffer).substr(4, 4);
+	std::string_view missing = std::string_view(buffer).substr(8);
+	EXPECT_TRUE(schm.contains(sect_name));
+	EXPECT_FALSE(schm.contains(missing));
+	EXPECT_TRUE(schm[sect_name].contains(opt_name));
+	EXPECT_FALSE(schm[sect_name].contains(missing));
+	EXPECT_EQ(schm[sect_name][opt_name].get_name(), "opt1");
+	EXPECT_THROW(schm[missing], not_found_exception);
+	EXPECT_THROW(schm[sect_name][missing], not_found_exception);
+}
+
+TEST(schema, assigning_through_lookup)
+{
+	schema schm;
+	section_schema_params params;
+	params.name = "a";
+	schm.add_section(params);
+	params.name = "b";
+	schm.add_section(params);
+
+	// stored section can be replaced by schema with different name, lookup still works
+	params.name = "a very long name which does not fit into small string buffer";
+	schm["a"] = section_schema(params);
+	EXPECT_TRUE(schm.contains("a"));
+	EXPECT_EQ(schm["a"].get_name(), params.name);
+	EXPECT_TRUE(schm.contains("b"));
+	EXPECT_FALSE(schm.contains(params.name));
+}
+
 TEST(schema, validate_config)
 {
 	// create testing schema
@@ -126,6 +200,81 @@ TEST(schema, validate_config)
 	EXPECT_THROW(schm.validate_config(conf, schema_mode::strict), validation_exception);
 }
 
+TEST(schema, parallel_validation)
+{
+	// schema of many sections, some of them are missing in config
+	schema schm;
+	section_schema_params sect_params;
+	option_schema_params<signed_ini_t> opt_params;
+	opt_params.name = "number";
+	opt_params.validator = [](signed_ini_t value) { return value >= 0; };
+	option_schema_params<string_ini_t> default_params;
+	default_params.name = "text";
+	default_params.requirement = item_requirement::optional;
+	default_params.default_value = "default";
+	std::string str;
+	for (int i = 0; i < 500; ++i) {
+		sect_params.name = "section" + std::to_string(i);
+		sect_params.requirement = i % 10 == 9 ? item_requirement::optional : item_requirement::mandatory;
+		schm.add_section(sect_params);
+		schm.add_option(sect_params.name, opt_params);
+		schm.add_option(sect_params.name, default_params);
+		if (i % 10 != 9) {
+			str += "[section" + std::to_string(i) + "]\nnumber = " + std::to_string(i) + "\n";
+		}
+	}
+	str += "[unknown]\nopt = val\n";
+
+	// result is the same as with serial validation
+	thread_executor executor(4);
+	config expected = parser::load(str);
+	config cfg = expected;
+	schm.validate_config(expected, schema_mode::relaxed);
+	cfg.validate(schm, schema_mode::relaxed, executor);
+	EXPECT_TRUE(cfg == expected);
+	EXPECT_EQ(cfg["section8"]["number"].get_ref<signed_ini_t>(), 8);
+	EXPECT_EQ(cfg["section8"]["text"].get<string_ini_t>(), "default");
+	EXPECT_TRUE(cfg.contains("section499"));
+
+	// the first error in the order of schema is reported
+	std::string broken = str;
+	broken.replace(broken.find("number = 300"), 12, "number = -300");
+	broken.replace(broken.find("number = 200"), 12, "number = -200");
+	for (int i = 0; i < 10; ++i) {
+		config broken_cfg = parser::load(broken);
+		try {
+			broken_cfg.validate(schm, schema_mode::relaxed, executor);
+			FAIL();
+		} catch (validation_exception &e) {
+			EXPECT_STREQ(e.what(), "Option 'number' - validation failed");
+			EXPECT_TRUE(broken_cfg.contains("section189"));
+			EXPECT_FALSE(broken_cfg.contains("section209"));
+			// unlike in serial validation, sections after the failed one are validated too
+			EXPECT_TRUE(broken_cfg["section250"].contains("text"));
+		}
+	}
+	config serial_broken_cfg = parser::load(broken);
+	EXPECT_THROW(schm.validate_config(serial_broken_cfg, schema_mode::relaxed), validation_exception);
+	EXPECT_TRUE(serial_broken_cfg["section150"].contains("text"));
+	EXPECT_FALSE(serial_broken_cfg["section250"].contains("text"));
+	config strict_cfg = parser::load(str);
+	EXPECT_THROW(strict_cfg.validate(schm, schema_mode::strict, executor), validation_exception);
+	config missing_cfg = parser::load(str.substr(str.find("[section1]")));
+	try {
+		missing_cfg.validate(schm, schema_mode::relaxed, executor);
+		FAIL();
+	} catch (validation_exception &e) {
+		EXPECT_STREQ(e.what(), "Mandatory section 'section0' is missing in config");
+	}
+
+	// config allocated in arena is validated as well
+	parser_options options;
+	options.use_arena = true;
+	config arena_cfg = parser::load(str, options);
+	arena_cfg.validate(schm, schema_mode::relaxed, executor);
+	EXPECT_TRUE(arena_cfg == expected);
+}
+
 TEST(schema, stream_output)
 {
 	// create testing schema
@@ -50,6 +50,59 @@ TEST(section_schema, creation_and_copying)
 	EXPECT_EQ(moved_assignment.get_name(), my_section.get_name());
 }
 
+TEST(section_schema, memory_resources)
+{
+	std::pmr::monotonic_buffer_resource memory;
+	section_schema_params params;
+	params.name = "name";
+	section_schema sect(params, section_schema::allocator_type(&memory));
+	option_schema_params<signed_ini_t> opt_params;
+	opt_params.name = "number";
+	sect.add_option(opt_params);
+	opt_params.name = "other";
+	sect.add_option(option_schema(opt_params));
+	EXPECT_EQ(sect.get_allocator().resource(), &memory);
+
+	// copies use default resource unless other is given
+	section_schema copied(sect);
+	EXPECT_EQ(copied.get_allocator().resource(), std::pmr::get_default_resource());
+	EXPECT_EQ(copied.size(), 2u);
+	EXPECT_TRUE(copied.contains("other"));
+	section_schema moved(std::move(copied), section_schema::allocator_type(&memory));
+	EXPECT_EQ(moved.get_allocator().resource(), &memory);
+	EXPECT_EQ(moved["number"].get_name(), "number");
+
+	// assignment keeps resource of the target
+	section_schema assigned(section_schema_params{});
+	assigned = std::move(moved);
+	EXPECT_EQ(assigned.get_allocator().resource(), std::pmr::get_default_resource());
+	EXPECT_EQ(assigned.size(), 2u);
+	EXPECT_TRUE(assigned.contains("number"));
+	assigned.remove_option("number");
+	EXPECT_FALSE(assigned.contains("number"));
+	EXPECT_TRUE(assigned.contains("other"));
+}
+
+TEST(section_schema, assigning_through_lookup)
+{
+	section_schema_params params;
+	params.name = "name";
+	section_schema sect(params);
+	option_schema_params<signed_ini_t> opt_params;
+	opt_params.name = "a";
+	sect.add_option(opt_params);
+	opt_params.name = "b";
+	sect.add_option(opt_params);
+
+	// stored option can be replaced by schema with different name, lookup still works
+	opt_params.name = "a very long name which does not fit into small string buffer";
+	sect["a"] = option_schema(opt_params);
+	EXPECT_TRUE(sect.contains("a"));
+	EXPECT_EQ(sect["a"].get_name(), opt_params.name);
+	EXPECT_TRUE(sect.contains("b"));
+	EXPECT_FALSE(sect.contains(opt_params.name));
+}
+
 TEST(section_schema, querying_properties)
 {
 	section_schema_params params;
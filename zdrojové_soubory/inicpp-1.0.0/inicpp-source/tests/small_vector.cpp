@@ -0,0 +1,84 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "small_vector.h"
+
+using namespace inicpp;
+
+
+TEST(small_vector, inline_and_heap_storage)
+{
+	small_vector<std::string, 2> list;
+	EXPECT_TRUE(list.empty());
+	EXPECT_EQ(list.capacity(), 2u);
+
+	list.push_back("first");
+	list.push_back("a string which is too long for small string optimization");
+	EXPECT_EQ(list.capacity(), 2u);
+	const std::string *inline_data = list.data();
+
+	// spills to heap buffer
+	list.push_back("third");
+	EXPECT_NE(list.data(), inline_data);
+	EXPECT_GE(list.capacity(), 3u);
+	EXPECT_EQ(std::vector<std::string>(list.begin(), list.end()),
+		std::vector<std::string>(
+			{"first", "a string which is too long for small string optimization", "third"}));
+
+	// pushed element can refer to the container itself
+	list.push_back(list[0]);
+	EXPECT_EQ(list[3], "first");
+}
+
+TEST(small_vector, insert_and_erase)
+{
+	small_vector<int, 4> list;
+	for (int i = 0; i < 3; ++i) {
+		list.push_back(i);
+	}
+	list.insert(list.begin(), -1);
+	list.insert(list.begin() + 2, 10);
+	list.insert(list.end(), 20);
+	EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({-1, 0, 10, 1, 2, 20}));
+
+	list.erase(list.begin());
+	list.erase(list.begin() + 1);
+	list.erase(list.end() - 1);
+	EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({0, 1, 2}));
+
+	list.clear();
+	EXPECT_EQ(list.size(), 0u);
+}
+
+TEST(small_vector, copy_and_move)
+{
+	std::vector<std::string> values({"a", "b", "c"});
+	small_vector<std::string, 1> heap_list(values.begin(), values.end());
+	small_vector<std::string, 1> inline_list;
+	inline_list.push_back("x");
+
+	// copies are independent
+	small_vector<std::string, 1> copy(heap_list);
+	copy[0] = "changed";
+	EXPECT_EQ(heap_list[0], "a");
+	EXPECT_FALSE(copy == heap_list);
+	copy = heap_list;
+	EXPECT_TRUE(copy == heap_list);
+
+	// moves take heap buffer or move inline elements, source is empty
+	small_vector<std::string, 1> moved_heap(std::move(heap_list));
+	EXPECT_EQ(moved_heap.size(), 3u);
+	EXPECT_TRUE(heap_list.empty());
+	small_vector<std::string, 1> moved_inline(std::move(inline_list));
+	EXPECT_EQ(moved_inline[0], "x");
+	EXPECT_TRUE(inline_list.empty());
+
+	moved_inline = std::move(moved_heap);
+	EXPECT_EQ(moved_inline.size(), 3u);
+	EXPECT_EQ(moved_inline[2], "c");
+	moved_inline = copy;
+	EXPECT_TRUE(moved_inline == copy);
+}
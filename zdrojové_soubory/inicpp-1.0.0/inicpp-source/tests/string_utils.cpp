@@ -46,6 +46,137 @@ TEST(string_utils, trim)
 	ASSERT_EQ("Hello World!", trim(str));
 }
 
+TEST(string_utils, trim_view)
+{
+	string str = " \t Hello World! \n";
+	string_view view = str;
+
+	EXPECT_EQ(left_trim(view), "Hello World! \n");
+	EXPECT_EQ(right_trim(view), " \t Hello World!");
+	EXPECT_EQ(trim(view), "Hello World!");
+
+	// result has to point into the original buffer
+	EXPECT_EQ(trim(view).data(), str.data() + 3);
+
+	view = "                    ";
+	EXPECT_TRUE(left_trim(view).empty());
+	EXPECT_TRUE(right_trim(view).empty());
+	EXPECT_TRUE(trim(view).empty());
+
+	view = "";
+	EXPECT_TRUE(trim(view).empty());
+}
+
+namespace
+{
+	/** Straightforward implementation used as reference for vectorized scanning. */
+	size_t reference_find_first_nonescaped(const string &str, char ch)
+	{
+		bool escaped = false;
+		for (size_t i = 0; i < str.length(); ++i) {
+			if (escaped) {
+				escaped = false;
+			} else if (str[i] == '\\') {
+				escaped = true;
+			} else if (str[i] == ch) {
+				return i;
+			}
+		}
+		return string::npos;
+	}
+
+	/** Straightforward implementation used as reference for vectorized scanning. */
+	size_t reference_find_last_escaped(const string &str, char ch)
+	{
+		size_t result = string::npos;
+		bool escaped = false;
+		for (size_t i = 0; i < str.length(); ++i) {
+			if (escaped) {
+				escaped = false;
+				if (str[i] == ch) {
+					result = i;
+				}
+			} else if (str[i] == '\\') {
+				escaped = true;
+			}
+		}
+		return result;
+	}
+}
+
+TEST(string_utils, find_first_nonescaped)
+{
+	EXPECT_EQ(find_first_nonescaped("", ';'), string::npos);
+	EXPECT_EQ(find_first_nonescaped("abc;def", ';'), 3u);
+	EXPECT_EQ(find_first_nonescaped("abc\\;def", ';'), string::npos);
+	EXPECT_EQ(find_first_nonescaped("abc\\\\;def", ';'), 5u);
+
+	// long strings, escaping sequences crossing 64 byte blocks
+	string str(63, 'a');
+	str += "\\;;";
+	EXPECT_EQ(find_first_nonescaped(str, ';'), 65u);
+	str = string(62, 'a') + "\\\\\\;" + string(100, 'b') + ";";
+	EXPECT_EQ(find_first_nonescaped(str, ';'), 166u);
+	str = string(200, 'a');
+	EXPECT_EQ(find_first_nonescaped(str, ';'), string::npos);
+
+	// pseudo-random strings compared with the simple implementation
+	const char alphabet[] = {'a', '\\', ';', ',', ' '};
+	unsigned seed = 42;
+	for (size_t length = 0; length < 300; ++length) {
+		str.clear();
+		for (size_t i = 0; i < length; ++i) {
+			seed = seed * 1103515245 + 12345;
+			str.push_back(alphabet[(seed >> 16) % sizeof(alphabet)]);
+		}
+		EXPECT_EQ(find_first_nonescaped(str, ';'), reference_find_first_nonescaped(str, ';'));
+		EXPECT_EQ(find_first_nonescaped(str, ','), reference_find_first_nonescaped(str, ','));
+		EXPECT_EQ(find_last_escaped(str, ' '), reference_find_last_escaped(str, ' '));
+		EXPECT_EQ(find_last_escaped(str, '\\'), reference_find_last_escaped(str, '\\'));
+	}
+}
+
+TEST(string_utils, find_last_escaped)
+{
+	EXPECT_EQ(find_last_escaped("", ' '), string::npos);
+	EXPECT_EQ(find_last_escaped("a\\ b\\ ", ' '), 5u);
+	EXPECT_EQ(find_last_escaped("a\\\\ ", ' '), string::npos);
+	EXPECT_EQ(find_last_escaped("a ", ' '), string::npos);
+
+	string str = string(100, 'a') + "\\ " + string(100, 'b') + "\\\\ ";
+	EXPECT_EQ(find_last_escaped(str, ' '), 101u);
+}
+
+TEST(string_utils, escape_and_unescape)
+{
+	EXPECT_EQ(unescape(""), "");
+	EXPECT_EQ(unescape("plain value"), "plain value");
+	EXPECT_EQ(unescape("a\\,b\\;c"), "a,b;c");
+	EXPECT_EQ(unescape("a\\\\b"), "a\\b");
+	EXPECT_EQ(unescape("\\ a\\ "), " a ");
+	EXPECT_EQ(unescape("trailing\\"), "trailing");
+
+	// output buffer is appended to
+	string out = "prefix:";
+	unescape("a\\:b", out);
+	EXPECT_EQ(out, "prefix:a:b");
+
+	EXPECT_EQ(escape(""), "");
+	EXPECT_EQ(escape("plain value"), "plain value");
+	EXPECT_EQ(escape("a,b;c:d\\e"), "a\\,b\\;c\\:d\\\\e");
+	EXPECT_EQ(escape(" a "), "\\ a\\ ");
+	EXPECT_EQ(escape(" "), "\\ ");
+
+	out = "prefix:";
+	escape("a,b", out);
+	EXPECT_EQ(out, "prefix:a\\,b");
+
+	// unescape is inverse of escape
+	for (string value : {"", "a", " a b ", "C:\\dir\\file;1", "x,y:z", "\\\\\\"}) {
+		EXPECT_EQ(unescape(escape(value)), value);
+	}
+}
+
 TEST(string_utils, starts_with)
 {
 	string str = "";
@@ -0,0 +1,170 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "value_constraints.h"
+
+using namespace inicpp;
+
+
+namespace
+{
+	/** Determines whether given values satisfy the constraints */
+	template <typename ValueType>
+	bool satisfies(const value_constraints<ValueType> &constraints, const std::vector<ValueType> &values)
+	{
+		try {
+			constraints.validate(value_view<ValueType>(values.data(), values.size()), "name");
+			return true;
+		} catch (const validation_exception &) {
+			return false;
+		}
+	}
+
+	/** Written form of given constraints */
+	template <typename ValueType> std::string written(const value_constraints<ValueType> &constraints)
+	{
+		std::ostringstream str;
+		constraints.write(str);
+		return str.str();
+	}
+}
+
+
+TEST(value_constraints, numeric_values)
+{
+	value_constraints<signed_ini_t> constraints;
+	EXPECT_TRUE(constraints.empty());
+	EXPECT_TRUE(satisfies<signed_ini_t>(constraints, {-5, 0, 500}));
+
+	constraints.range(-10, 10);
+	EXPECT_FALSE(constraints.empty());
+	EXPECT_TRUE(satisfies<signed_ini_t>(constraints, {-10, 0, 10}));
+	EXPECT_FALSE(satisfies<signed_ini_t>(constraints, {-10, 11, 10}));
+	EXPECT_FALSE(satisfies<signed_ini_t>(constraints, {-11}));
+	EXPECT_TRUE(satisfies<signed_ini_t>(constraints, {}));
+
+	// long lists are checked as a whole
+	std::vector<signed_ini_t> values(1000, 3);
+	EXPECT_TRUE(satisfies(constraints, values));
+	values[999] = 20;
+	EXPECT_FALSE(satisfies(constraints, values));
+
+	value_constraints<float_ini_t> floats;
+	floats.at_least(0.5);
+	EXPECT_TRUE(satisfies<float_ini_t>(floats, {0.5, 1e300}));
+	EXPECT_FALSE(satisfies<float_ini_t>(floats, {0.4}));
+	floats.at_most(1.0);
+	EXPECT_FALSE(satisfies<float_ini_t>(floats, {0.7, 1.5}));
+
+	// missing bound of floating point values allows infinity
+	const float_ini_t inf = std::numeric_limits<float_ini_t>::infinity();
+	const float_ini_t nan = std::numeric_limits<float_ini_t>::quiet_NaN();
+	value_constraints<float_ini_t> lower;
+	lower.at_least(0.5);
+	EXPECT_TRUE(satisfies<float_ini_t>(lower, {inf}));
+	EXPECT_FALSE(satisfies<float_ini_t>(lower, {-inf}));
+	EXPECT_FALSE(satisfies<float_ini_t>(lower, {nan}));
+	value_constraints<float_ini_t> upper;
+	upper.at_most(0.5);
+	EXPECT_TRUE(satisfies<float_ini_t>(upper, {-inf}));
+	EXPECT_FALSE(satisfies<float_ini_t>(upper, {inf}));
+
+	value_constraints<unsigned_ini_t> allowed;
+	allowed.one_of({8, 2, 4, 2});
+	EXPECT_TRUE(satisfies<unsigned_ini_t>(allowed, {2, 4, 8, 8}));
+	EXPECT_FALSE(satisfies<unsigned_ini_t>(allowed, {2, 3}));
+
+	// NaN equals no value, so it is never allowed
+	value_constraints<float_ini_t> allowed_floats;
+	allowed_floats.one_of({1.0, nan, 2.0});
+	EXPECT_TRUE(satisfies<float_ini_t>(allowed_floats, {2.0, 1.0}));
+	EXPECT_FALSE(satisfies<float_ini_t>(allowed_floats, {nan}));
+}
+
+TEST(value_constraints, textual_values)
+{
+	value_constraints<string_ini_t> constraints;
+	constraints.length(2, 4);
+	EXPECT_TRUE(satisfies<string_ini_t>(constraints, {"ab", "abcd"}));
+	EXPECT_FALSE(satisfies<string_ini_t>(constraints, {"a"}));
+	EXPECT_FALSE(satisfies<string_ini_t>(constraints, {"abcde"}));
+
+	constraints.matches("[a-z]+[0-9]?");
+	EXPECT_TRUE(satisfies<string_ini_t>(constraints, {"ab", "abc1"}));
+	EXPECT_FALSE(satisfies<string_ini_t>(constraints, {"ab1c"}));
+	EXPECT_THROW(constraints.matches("[a-"), invalid_type_exception);
+
+	// copies share compiled pattern and keep working on their own
+	value_constraints<string_ini_t> copy = constraints;
+	constraints = value_constraints<string_ini_t>();
+	EXPECT_FALSE(satisfies<string_ini_t>(copy, {"AB"}));
+	EXPECT_TRUE(satisfies<string_ini_t>(constraints, {"AB"}));
+
+	value_constraints<enum_ini_t> enums;
+	enums.one_of({"red", "green"}).matches("[a-z]+");
+	EXPECT_TRUE(satisfies<enum_ini_t>(enums, {"green", "red"}));
+	EXPECT_FALSE(satisfies<enum_ini_t>(enums, {"blue"}));
+}
+
+TEST(value_constraints, lists)
+{
+	value_constraints<signed_ini_t> ascending;
+	ascending.ordered(list_order::ascending);
+	EXPECT_TRUE(satisfies<signed_ini_t>(ascending, {1, 1, 2, 5}));
+	EXPECT_FALSE(satisfies<signed_ini_t>(ascending, {1, 3, 2}));
+	ascending.ordered(list_order::strictly_ascending);
+	EXPECT_FALSE(satisfies<signed_ini_t>(ascending, {1, 1, 2}));
+	ascending.ordered(list_order::strictly_descending);
+	EXPECT_TRUE(satisfies<signed_ini_t>(ascending, {3, 2, 1}));
+	EXPECT_TRUE(satisfies<signed_ini_t>(ascending, {3}));
+
+	value_constraints<string_ini_t> unique;
+	unique.unique();
+	EXPECT_TRUE(satisfies<string_ini_t>(unique, {"a", "b", "c"}));
+	EXPECT_FALSE(satisfies<string_ini_t>(unique, {"a", "b", "a"}));
+
+	// long lists are sorted instead of comparing all pairs
+	std::vector<string_ini_t> values;
+	for (int i = 0; i < 100; ++i) {
+		values.push_back(std::to_string(i));
+	}
+	EXPECT_TRUE(satisfies(unique, values));
+	values.push_back("42");
+	EXPECT_FALSE(satisfies(unique, values));
+
+	// NaN differs from all values regardless of length of the list
+	const float_ini_t nan = std::numeric_limits<float_ini_t>::quiet_NaN();
+	value_constraints<float_ini_t> unique_floats;
+	unique_floats.unique();
+	EXPECT_TRUE(satisfies<float_ini_t>(unique_floats, {nan, 1.0, nan}));
+	std::vector<float_ini_t> floats;
+	for (int i = 0; i < 20; ++i) {
+		floats.push_back(i % 4 == 0 ? nan : i);
+	}
+	EXPECT_TRUE(satisfies(unique_floats, floats));
+	floats.push_back(7.0);
+	EXPECT_FALSE(satisfies(unique_floats, floats));
+	EXPECT_FALSE(satisfies<float_ini_t>(unique_floats, {nan, 1.0, 1.0}));
+}
+
+TEST(value_constraints, writing)
+{
+	value_constraints<signed_ini_t> numbers;
+	EXPECT_EQ(written(numbers), "");
+	numbers.range(-1, 5).one_of({3, 1}).ordered(list_order::descending).unique();
+	EXPECT_EQ(written(numbers), "range [-1, 5], one of {1, 3}, descending, unique");
+	value_constraints<float_ini_t> floats;
+	floats.at_most(1.5);
+	EXPECT_EQ(written(floats), "range (, 1.5]");
+	value_constraints<boolean_ini_t> booleans;
+	booleans.one_of({true, false});
+	EXPECT_EQ(written(booleans), "one of {no, yes}");
+
+	value_constraints<string_ini_t> strings;
+	strings.length(1).matches("a,b*").one_of({"x,y"});
+	EXPECT_EQ(written(strings), "one of {x\\,y}, length [1, ), pattern \"a,b*\"");
+}